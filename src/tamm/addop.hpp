@@ -6,12 +6,14 @@
 #include <chrono>
 #include <iostream>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "tamm/block_assign_plan.hpp"
 #include "tamm/block_operations.hpp"
 #include "tamm/boundvec.hpp"
 #include "tamm/errors.hpp"
+#include "tamm/fused_addop.hpp"
 #include "tamm/kernels/assign.hpp"
 #include "tamm/label_translator.hpp"
 #include "tamm/labeled_tensor.hpp"
@@ -24,6 +26,26 @@
 
 namespace tamm {
 
+namespace detail {
+// TAMM_FLAT_ADD_CHUNK_SIZE = 1048576(default)
+// Number of elements per transfer when a flat add streams the buffer of a remote rank.
+static const size_t tamm_flat_add_chunk_size = [] {
+  int64_t chunk_size = 1048576;
+  if(const char* tammChunkSize = std::getenv("TAMM_FLAT_ADD_CHUNK_SIZE")) {
+    chunk_size = std::atoll(tammChunkSize);
+  }
+  return static_cast<size_t>(std::max<int64_t>(chunk_size, 1));
+}();
+} // namespace detail
+
+/**
+ * @brief Per-operation settings of an AddOp. The defaults are read from the environment.
+ */
+struct AddOpOptions {
+  /// Elements per transfer when a flat add streams a remote buffer (TAMM_FLAT_ADD_CHUNK_SIZE)
+  size_t flat_chunk_size = detail::tamm_flat_add_chunk_size;
+};
+
 /**
  * @brief AddOp implementation using new BlockPlans
  *
@@ -179,8 +201,10 @@ struct GeneralLHSAddPlan: public AddOpPlanBase<T, LabeledTensorT1, LabeledTensor
 
 namespace tamm {
 template<typename T, typename LabeledTensorT1, typename LabeledTensorT2>
-class AddOp: public Op {
+class AddOp: public FusableAddOp<LabeledTensorT1, LabeledTensorT2> {
 public:
+  using AddTermT = internal::AddTerm<LabeledTensorT1, LabeledTensorT2>;
+
   AddOp() = default;
   AddOp(LabeledTensorT1 lhs, T alpha, LabeledTensorT2 rhs, bool is_assign):
     lhs_{lhs}, alpha_{alpha}, rhs_{rhs}, is_assign_{is_assign} {
@@ -218,8 +242,45 @@ public:
 
   bool is_assign() const { return is_assign_; }
 
+  /**
+   * @brief Set a per-element epilogue applied to alpha*rhs for each LHS block before it is
+   * added to (or assigned into) the LHS. The epilogue receives the global indices of the
+   * element in the LHS tensor.
+   */
+  AddOp& set_epilogue(ElementEpilogue<typename LabeledTensorT1::element_type> epilogue) {
+    epilogue_ = std::move(epilogue);
+    return *this;
+  }
+
+  const ElementEpilogue<typename LabeledTensorT1::element_type>& epilogue() const {
+    return epilogue_;
+  }
+
+  /**
+   * @brief Override the transfer settings of this operation. The defaults are taken from the
+   * TAMM_FLAT_ADD_* environment variables.
+   */
+  AddOp& set_options(const AddOpOptions& options) {
+    options_ = options;
+    return *this;
+  }
+
+  const AddOpOptions& options() const { return options_; }
+
   OpType op_type() const override { return OpType::add; }
 
+  std::vector<AddTermT> add_terms() const override {
+    if(is_assign_ || epilogue_ || !internal::is_fusable_add(lhs_, rhs_)) return {};
+    return {AddTermT{lhs_, alpha_, rhs_, clone()}};
+  }
+
+  std::shared_ptr<Op> first_write_form() const override {
+    if(epilogue_ || !internal::is_fusable_add(lhs_, rhs_)) return nullptr;
+    auto op        = std::make_shared<AddOp<T, LabeledTensorT1, LabeledTensorT2>>(*this);
+    op->is_assign_ = true;
+    return op;
+  }
+
   OpList canonicalize() const override {
     OpList result{};
 
@@ -228,6 +289,8 @@ public:
       auto assign_op = (lhs = 0);
       result.push_back(assign_op.clone());
       AddOp n_op{lhs_, alpha_, rhs_, false};
+      n_op.set_epilogue(epilogue_);
+      n_op.set_options(options_);
       result.push_back(n_op.clone());
     }
     else { result.push_back((*this).clone()); }
@@ -246,7 +309,7 @@ public:
        rhs_.tensor().kind() != TensorBase::TensorKind::view &&
        lhs_.tensor().kind() != TensorBase::TensorKind::view && lhs_.labels() == rhs_.labels() &&
        !internal::is_slicing(lhs_) && !internal::is_slicing(rhs_) &&
-       lhs_.tensor().has_spin() == rhs_.tensor().has_spin() &&
+       lhs_.tensor().has_spin() == rhs_.tensor().has_spin() && !epilogue_ &&
        lhs_.tensor().execution_context()->pg() == rhs_.tensor().execution_context()->pg() &&
        lhs_.tensor().distribution() == rhs_.tensor().distribution()) {
       plan_     = Plan::flat;
@@ -407,6 +470,9 @@ protected:
   IntLabelVec     lhs_int_labels_, rhs_int_labels_;
   bool            is_assign_;
 
+  ElementEpilogue<typename LabeledTensorT1::element_type> epilogue_;
+  AddOpOptions                                            options_;
+
   enum class Plan { invalid, lhs, flat, general_lhs, general_flat };
   Plan plan_ = Plan::invalid;
   std::shared_ptr<internal::AddOpPlanBase<T, LabeledTensorT1, LabeledTensorT2>> plan_obj_;
@@ -422,6 +488,28 @@ namespace tamm::internal {
 template<typename T, typename LabeledTensorT1, typename LabeledTensorT2>
 using AddOpT = AddOp<T, LabeledTensorT1, LabeledTensorT2>;
 
+/**
+ * @brief lhs (+)= epilogue(alpha * rhs) for one LHS block whose first element has global
+ * indices @p offsets.
+ */
+template<typename T, typename LabeledTensorT1, typename LabeledTensorT2, typename T1, typename T2>
+void apply_with_epilogue(const AddOpT<T, LabeledTensorT1, LabeledTensorT2>& addop,
+                         BlockSpan<T1>& lhs_span, Scalar alpha, const BlockSpan<T2>& rhs_span,
+                         const std::vector<size_t>& offsets) {
+  auto            lhs_lt = addop.lhs();
+  auto            rhs_lt = addop.rhs();
+  std::vector<T1> update(lhs_span.num_elements());
+  BlockSpan<T1>   update_span{update.data(), lhs_span.block_dims()};
+  BlockAssignPlan set_plan{lhs_lt.labels(), rhs_lt.labels(), BlockAssignPlan::OpType::set};
+  set_plan.apply(update_span, alpha, rhs_span);
+  apply_epilogue(addop.epilogue(), update.data(), lhs_span.block_dims(), offsets);
+  T1* lhs_buf = lhs_span.buf();
+  if(addop.is_assign()) std::copy(update.begin(), update.end(), lhs_buf);
+  else {
+    for(size_t i = 0; i < update.size(); i++) lhs_buf[i] += update[i];
+  }
+}
+
 template<typename T, typename LabeledTensorT1, typename LabeledTensorT2>
 void FlatAddPlan<T, LabeledTensorT1, LabeledTensorT2>::apply(const AddOpT&     addop,
                                                              ExecutionContext& ec, ExecutionHW hw) {
@@ -436,14 +524,16 @@ void FlatAddPlan<T, LabeledTensorT1, LabeledTensorT2>::apply(const AddOpT&     a
   size_t              lhs_size = lhs_lt.tensor().local_buf_size();
   std::vector<size_t> lhs_dims{lhs_size};
 
-  T2*                 rhs_buf  = rhs_lt.tensor().access_local_buf();
-  size_t              rhs_size = rhs_lt.tensor().local_buf_size();
+  // the RHS is only read, through its const buffer so that its cached block norms stay valid
+  const Tensor<T2>    rhs_tensor = rhs_lt.tensor();
+  const T2*           rhs_buf    = rhs_tensor.access_local_buf();
+  size_t              rhs_size   = rhs_tensor.local_buf_size();
   std::vector<size_t> rhs_dims{rhs_size};
 
   EXPECTS(rhs_size == lhs_size);
 
   BlockSpan<T1> lhs_span{lhs_buf, lhs_dims};
-  BlockSpan<T2> rhs_span{rhs_buf, rhs_dims};
+  BlockSpan<T2> rhs_span{const_cast<T2*>(rhs_buf), rhs_dims};
 
   BlockAssignPlan::OpType optype = is_assign ? BlockAssignPlan::OpType::set
                                              : BlockAssignPlan::OpType::update;
@@ -481,6 +571,12 @@ void LHSAddPlan<T, LabeledTensorT1, LabeledTensorT2>::apply(const AddOpT&     ad
 
   BlockAssignPlan plan{lhs_lt.labels(), rhs_lt.labels(), optype};
 
+  // When both tensors share a distribution (checked once here), RHS blocks owned by this rank
+  // are read in place from its local buffer. A block with the LHS block's id sits at the LHS
+  // offset, any other one is located.
+  const T2* rhs_local_buf =
+    ldist == rdist ? internal::local_read_buf_if_owner(rhs_lt.tensor(), ec) : nullptr;
+
   auto lambda = [&](const IndexVector& l_blockid, Offset l_offset, const IndexVector& r_blockid) {
     auto lhs_tensor = lhs_lt.tensor();
     auto rhs_tensor = rhs_lt.tensor();
@@ -492,14 +588,28 @@ void LHSAddPlan<T, LabeledTensorT1, LabeledTensorT2>::apply(const AddOpT&     ad
     auto rhs_blocksize = rhs_tensor.block_size(r_blockid);
     auto rhs_blockdims = rhs_tensor.block_dims(r_blockid);
 
-    std::vector<T2> rhs_buf(rhs_blocksize);
-
-    rhs_tensor.get(r_blockid, rhs_buf);
+    std::vector<T2> rhs_buf;
+    const T2*       rhs_ptr = nullptr;
+    if(rhs_local_buf != nullptr) {
+      if(r_blockid == l_blockid) { rhs_ptr = rhs_local_buf + l_offset.value(); }
+      else {
+        auto [rhs_proc, rhs_offset] = rdist.locate(r_blockid);
+        if(rhs_proc == me) { rhs_ptr = rhs_local_buf + rhs_offset.value(); }
+      }
+    }
+    if(rhs_ptr == nullptr) {
+      rhs_buf.resize(rhs_blocksize);
+      rhs_tensor.get(r_blockid, rhs_buf);
+      rhs_ptr = rhs_buf.data();
+    }
 
     BlockSpan<T1> lhs_span{lhs_buf, lhs_blockdims};
-    BlockSpan<T2> rhs_span{rhs_buf.data(), rhs_blockdims};
+    BlockSpan<T2> rhs_span{const_cast<T2*>(rhs_ptr), rhs_blockdims};
 
-    plan.apply(lhs_span, alpha, rhs_span);
+    if(addop.epilogue()) {
+      apply_with_epilogue(addop, lhs_span, alpha, rhs_span, lhs_tensor.block_offsets(l_blockid));
+    }
+    else { plan.apply(lhs_span, alpha, rhs_span); }
   };
 
   internal::LabelTranslator translator{merged_use_labels, merged_alloc_labels};
@@ -508,13 +618,21 @@ void LHSAddPlan<T, LabeledTensorT1, LabeledTensorT2>::apply(const AddOpT&     ad
     auto [l_blockid, r_blockid]          = internal::split_vector<IndexVector, 2>(
       translated_blockid, {lhs_lt.labels().size(), rhs_lt.labels().size()});
 
-    if(!lhs_lt.tensor().is_non_zero(l_blockid) || !rhs_lt.tensor().is_non_zero(r_blockid)) {
-      continue;
-    }
+    if(!tlb_valid || !lhs_lt.tensor().is_non_zero(l_blockid)) { continue; }
 
     auto [lhs_proc, lhs_offset] = ldist.locate(l_blockid);
-
-    if(tlb_valid && lhs_proc == me) { lambda(l_blockid, lhs_offset, r_blockid); }
+    if(lhs_proc != me) { continue; }
+
+    if(!rhs_lt.tensor().is_non_zero(r_blockid)) {
+      // assigning a zero RHS block zeroes the LHS block
+      if(is_assign) {
+        auto lhs_tensor = lhs_lt.tensor();
+        std::fill_n(lhs_tensor.access_local_buf() + lhs_offset.value(),
+                    lhs_tensor.block_size(l_blockid), T1{0});
+      }
+      continue;
+    }
+    lambda(l_blockid, lhs_offset, r_blockid);
   }
 }
 
@@ -566,55 +684,83 @@ void GeneralFlatAddPlan<T, LabeledTensorT1, LabeledTensorT2>::apply(const AddOpT
       assigned_proc = round_robin_counter++ % ec_pg_size;
     }
 
-    if(proc_me_in_ec == assigned_proc) {
-      bool alloced_lhs_buf{false};
-      bool alloced_rhs_buf{false};
-      T1*  lhs_buf{nullptr};
-      T2*  rhs_buf{nullptr};
-
-      /// get total buffer size for a given Proc
-      size_t lhs_size = lhs_tensor.total_buf_size(i);
-      size_t rhs_size = rhs_tensor.total_buf_size(i);
-      EXPECTS(lhs_size == rhs_size);
-      if(lhs_size <= 0) continue;
-      if(proc_me_in_ec == pg_lhs_in_ec[i]) {
-        lhs_buf         = lhs_tensor.access_local_buf();
-        alloced_lhs_buf = false;
-      }
-      else {
-        lhs_buf              = new T1[lhs_size];
-        alloced_lhs_buf      = true;
-        auto* lhs_mem_region = lhs_tensor.memory_region();
-        /// get all of lhs's buf at i-th proc to lhs_buf
-        lhs_mem_region->get(Proc{i}, Offset{0}, Size{lhs_size}, lhs_buf);
-      }
-      if(proc_me_in_ec == pg_rhs_in_ec[i]) {
-        rhs_buf         = rhs_tensor.access_local_buf();
-        alloced_rhs_buf = false;
+    if(proc_me_in_ec != assigned_proc) { continue; }
+
+    /// get total buffer size for a given Proc
+    size_t lhs_size = lhs_tensor.total_buf_size(i);
+    size_t rhs_size = rhs_tensor.total_buf_size(i);
+    EXPECTS(lhs_size == rhs_size);
+    if(lhs_size <= 0) continue;
+
+    const bool lhs_is_local = proc_me_in_ec == pg_lhs_in_ec[i];
+    const bool rhs_is_local = proc_me_in_ec == pg_rhs_in_ec[i];
+    T1*        lhs_buf      = lhs_is_local ? lhs_tensor.access_local_buf() : nullptr;
+    // read-only access keeps the cached block norms of the RHS
+    const T2* rhs_buf = rhs_is_local ? std::as_const(rhs_tensor).access_local_buf() : nullptr;
+    if(lhs_is_local && rhs_is_local) {
+      BlockSpan<T1> lhs_span{lhs_buf, {lhs_size}};
+      BlockSpan<T2> rhs_span{const_cast<T2*>(rhs_buf), {rhs_size}};
+      plan.apply(lhs_span, alpha, rhs_span);
+      continue;
+    }
+
+    // Remote buffers of the i-th proc are streamed in chunks through two staging buffers each:
+    // chunk c+1 is fetched while chunk c is updated and chunk c-1 is written back.
+    auto*           lhs_mem_region = lhs_tensor.memory_region();
+    auto*           rhs_mem_region = rhs_tensor.memory_region();
+    const size_t    chunk_size     = std::min(addop.options().flat_chunk_size, lhs_size);
+    const size_t    nchunks        = (lhs_size + chunk_size - 1) / chunk_size;
+    std::vector<T1> lhs_chunks[2];
+    std::vector<T2> rhs_chunks[2];
+
+    DataCommunicationHandle lhs_gets[2], rhs_gets[2], lhs_puts[2];
+    for(int s = 0; s < 2; s++) {
+      if(!lhs_is_local) lhs_chunks[s].resize(chunk_size);
+      if(!rhs_is_local) rhs_chunks[s].resize(chunk_size);
+    }
+
+    auto fetch = [&](size_t c) {
+      const int    s  = c % 2;
+      const size_t lo = c * chunk_size;
+      const Size   n{std::min(chunk_size, lhs_size - lo)};
+      if(!lhs_is_local) {
+        // the staging buffer may still be written back from chunk c-2
+        lhs_puts[s].waitForCompletion();
+        // an assignment overwrites the chunk, so the old LHS values are not fetched
+        if(!is_assign) {
+          lhs_mem_region->mgr().nb_get(*lhs_mem_region, Proc{i}, Offset{lo}, n,
+                                       lhs_chunks[s].data(), &lhs_gets[s]);
+        }
       }
-      else {
-        rhs_buf         = new T2[rhs_size];
-        alloced_rhs_buf = true;
-        EXPECTS(rhs_buf != nullptr);
-        auto* rhs_mem_region = rhs_tensor.memory_region();
-        /// get all of rhs's buf at i-th proc to rhs_buf
-        rhs_mem_region->get(Proc{i}, Offset{0}, Size{rhs_size}, rhs_buf);
+      if(!rhs_is_local) {
+        rhs_mem_region->mgr().nb_get(*rhs_mem_region, Proc{i}, Offset{lo}, n, rhs_chunks[s].data(),
+                                     &rhs_gets[s]);
       }
-      std::vector<size_t> lhs_dims{lhs_size};
-      std::vector<size_t> rhs_dims{rhs_size};
-      BlockSpan<T1>       lhs_span{lhs_buf, lhs_dims};
-      BlockSpan<T2>       rhs_span{rhs_buf, rhs_dims};
-
+    };
+
+    fetch(0);
+    for(size_t c = 0; c < nchunks; c++) {
+      if(c + 1 < nchunks) fetch(c + 1);
+
+      const int    s  = c % 2;
+      const size_t lo = c * chunk_size;
+      const size_t n  = std::min(chunk_size, lhs_size - lo);
+      lhs_gets[s].waitForCompletion();
+      rhs_gets[s].waitForCompletion();
+
+      T1*           lhs_ptr = lhs_is_local ? lhs_buf + lo : lhs_chunks[s].data();
+      const T2*     rhs_ptr = rhs_is_local ? rhs_buf + lo : rhs_chunks[s].data();
+      BlockSpan<T1> lhs_span{lhs_ptr, {n}};
+      BlockSpan<T2> rhs_span{const_cast<T2*>(rhs_ptr), {n}};
       plan.apply(lhs_span, alpha, rhs_span);
-      if(proc_me_in_ec != pg_lhs_in_ec[i]) {
-        EXPECTS(lhs_buf != nullptr);
-        /// put lhs_buf to LHS tensor buffer on i-th proc
-        auto* lhs_mem_region = lhs_tensor.memory_region();
-        lhs_mem_region->put(Proc{i}, Offset{0}, Size{lhs_size}, lhs_buf);
+
+      if(!lhs_is_local) {
+        /// put the chunk back to LHS tensor buffer on i-th proc
+        lhs_mem_region->mgr().nb_put(*lhs_mem_region, Proc{i}, Offset{lo}, Size{n}, lhs_ptr,
+                                     &lhs_puts[s]);
       }
-      if(alloced_lhs_buf) { delete[] lhs_buf; }
-      if(alloced_rhs_buf) { delete[] rhs_buf; }
     }
+    for(auto& handle: lhs_puts) handle.waitForCompletion();
   }
 }
 
@@ -697,7 +843,10 @@ void GeneralLHSAddPlan<T, LabeledTensorT1, LabeledTensorT2>::apply(const AddOpT&
     BlockSpan<T1> lhs_span{lhs_buf, lhs_blockdims};
     BlockSpan<T2> rhs_span{rhs_buf, rhs_blockdims};
 
-    plan.apply(lhs_span, alpha, rhs_span);
+    if(addop.epilogue()) {
+      apply_with_epilogue(addop, lhs_span, alpha, rhs_span, lhs_tensor.block_offsets(l_blockid));
+    }
+    else { plan.apply(lhs_span, alpha, rhs_span); }
 
     if(proc_me_in_ec != proc_lhs_to_ec[lhs_proc.value()] ||
        lhs_tensor.kind() == TensorBase::TensorKind::view ||
@@ -4,6 +4,7 @@
 #include "tamm/block_span.hpp"
 #include "tamm/blockops_blas.hpp"
 #include "tamm/errors.hpp"
+#include "tamm/kernels/flat_ops.hpp"
 #include "tamm/tiled_index_space.hpp"
 #include "tamm/types.hpp"
 
@@ -194,66 +195,59 @@ private:
   void scalar_vec_mult_update(T beta, BlockSpan<T>& lhs_vec, T alpha,
                               const BlockSpan<T>& rhs1_scalar, const BlockSpan<T>& rhs2_vec) {
     EXPECTS(lhs_vec.num_elements() == rhs2_vec.num_elements());
-    for(size_t i = 0; i < lhs_vec.num_elements(); i++) {
-      auto new_alpha = alpha * rhs1_scalar[0];
-      blockops::cpu::flat_update(beta, lhs_vec, new_alpha, rhs2_vec);
-    }
+    auto new_alpha = alpha * rhs1_scalar[0];
+    blockops::cpu::flat_update(beta, lhs_vec, new_alpha, rhs2_vec);
   }
 
   template<typename T>
   void scalar_vec_mult_update(BlockSpan<T>& lhs_vec, T alpha, const BlockSpan<T>& rhs1_scalar,
                               const BlockSpan<T>& rhs2_vec) {
     EXPECTS(lhs_vec.num_elements() == rhs2_vec.num_elements());
-    for(size_t i = 0; i < lhs_vec.num_elements(); i++) {
-      auto new_alpha = alpha * rhs1_scalar[0];
-      blockops::cpu::flat_update(lhs_vec, new_alpha, rhs2_vec);
-    }
+    auto new_alpha = alpha * rhs1_scalar[0];
+    blockops::cpu::flat_update(lhs_vec, new_alpha, rhs2_vec);
   }
 
   template<typename T>
   void scalar_vec_mult_assign(BlockSpan<T>& lhs_vec, T alpha, const BlockSpan<T>& rhs1_scalar,
                               const BlockSpan<T>& rhs2_vec) {
     EXPECTS(lhs_vec.num_elements() == rhs2_vec.num_elements());
-    for(size_t i = 0; i < lhs_vec.num_elements(); i++) {
-      auto new_alpha = alpha * rhs1_scalar[0];
-      blockops::cpu::flat_assign(lhs_vec, new_alpha, rhs2_vec);
-    }
+    auto new_alpha = alpha * rhs1_scalar[0];
+    blockops::cpu::flat_assign(lhs_vec, new_alpha, rhs2_vec);
   }
 
   template<typename T>
   void vec_vec_mult_update(T beta, BlockSpan<T>& lhs_vec, T alpha, const BlockSpan<T>& rhs1_vec,
                            const BlockSpan<T>& rhs2_vec) {
-    for(size_t i = 0; i < lhs_vec.num_elements(); i++) {
-      lhs_vec[i] = (beta * lhs_vec[i]) + (alpha * rhs1_vec[i] * rhs2_vec[i]);
-    }
+    kernels::flat::hadamard(lhs_vec.buf(), beta, alpha, rhs1_vec.buf(), rhs2_vec.buf(),
+                            lhs_vec.num_elements());
   }
 
   template<typename T>
   void vec_vec_mult_update(BlockSpan<T>& lhs_vec, T alpha, const BlockSpan<T>& rhs1_vec,
                            const BlockSpan<T>& rhs2_vec) {
-    for(size_t i = 0; i < lhs_vec.num_elements(); i++) {
-      lhs_vec[i] += alpha * rhs1_vec[i] * rhs2_vec[i];
-    }
+    kernels::flat::hadamard(lhs_vec.buf(), T{1}, alpha, rhs1_vec.buf(), rhs2_vec.buf(),
+                            lhs_vec.num_elements());
   }
 
   template<typename T>
   void vec_vec_mult_update(BlockSpan<T>& lhs_vec, const BlockSpan<T>& rhs1_vec,
                            const BlockSpan<T>& rhs2_vec) {
-    for(size_t i = 0; i < lhs_vec.num_elements(); i++) { lhs_vec[i] += rhs1_vec[i] * rhs2_vec[i]; }
+    kernels::flat::hadamard(lhs_vec.buf(), T{1}, T{1}, rhs1_vec.buf(), rhs2_vec.buf(),
+                            lhs_vec.num_elements());
   }
 
   template<typename T>
   void vec_vec_mult_assign(BlockSpan<T>& lhs_vec, T alpha, const BlockSpan<T>& rhs1_vec,
                            const BlockSpan<T>& rhs2_vec) {
-    for(size_t i = 0; i < lhs_vec.num_elements(); i++) {
-      lhs_vec[i] = alpha * rhs1_vec[i] * rhs2_vec[i];
-    }
+    kernels::flat::hadamard(lhs_vec.buf(), T{0}, alpha, rhs1_vec.buf(), rhs2_vec.buf(),
+                            lhs_vec.num_elements());
   }
 
   template<typename T>
   void vec_vec_mult_assign(BlockSpan<T>& lhs_vec, const BlockSpan<T>& rhs1_vec,
                            const BlockSpan<T>& rhs2_vec) {
-    for(size_t i = 0; i < lhs_vec.num_elements(); i++) { lhs_vec[i] = rhs1_vec[i] * rhs2_vec[i]; }
+    kernels::flat::hadamard(lhs_vec.buf(), T{0}, T{1}, rhs1_vec.buf(), rhs2_vec.buf(),
+                            lhs_vec.num_elements());
   }
 
   IndexLabelVec lhs_labels_;
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <array>
+#include <numeric>
 #include <set>
 #include <vector>
 
 #include "tamm/block_span.hpp"
 #include "tamm/iteration.hpp"
+#include "tamm/kernels/flat_ops.hpp"
 #include "tamm/perm.hpp"
 //#include "tamm/scalar.hpp"
 #include "tamm/types.hpp"
@@ -20,22 +22,24 @@ namespace tamm::blockops::cpu {
 
 template<typename T1, typename T2>
 void flat_set(BlockSpan<T1>& lhs, const T2& value_) {
-  auto   buf          = lhs.buf();
-  size_t num_elements = lhs.num_elements();
-  for(size_t i = 0; i < num_elements; ++i) { buf[i] = value_; }
+  kernels::flat::set(lhs.buf(), static_cast<T1>(value_), lhs.num_elements());
 }
 
 template<typename T1, typename T2>
 void flat_update(BlockSpan<T1>& lhs, const T2& value_) {
-  auto   buf          = lhs.buf();
-  size_t num_elements = lhs.num_elements();
+  auto      buf          = lhs.buf();
+  size_t    num_elements = lhs.num_elements();
+  const int nthreads     = internal::kernel_threads(num_elements);
+#pragma omp parallel for schedule(static) num_threads(nthreads) if(nthreads > 1)
   for(size_t i = 0; i < num_elements; ++i) { buf[i] += value_; }
 }
 
 template<typename T1, typename T2, typename T3>
 void flat_update(const T1& scale, BlockSpan<T2>& lhs, const T3& value_) {
-  auto   buf          = lhs.buf();
-  size_t num_elements = lhs.num_elements();
+  auto      buf          = lhs.buf();
+  size_t    num_elements = lhs.num_elements();
+  const int nthreads     = internal::kernel_threads(num_elements);
+#pragma omp parallel for schedule(static) num_threads(nthreads) if(nthreads > 1)
   for(size_t i = 0; i < num_elements; ++i) { buf[i] = scale * buf[i] + value_; }
 }
 
@@ -176,7 +180,13 @@ void flat_assign(BlockSpan<TL>& lhs, const BlockSpan<TR>& rhs) {
   TL*          lbuf         = lhs.buf();
   const TR*    rbuf         = rhs.buf();
   const size_t num_elements = lhs.num_elements();
-  for(int i = 0; i < num_elements; i++) { *lbuf++ = *rbuf++; }
+  if constexpr(std::is_same_v<TL, TR>) {
+    kernels::flat::copy(lbuf, rbuf, num_elements);
+    return;
+  }
+  const int nthreads = internal::kernel_threads(num_elements);
+#pragma omp parallel for schedule(static) num_threads(nthreads) if(nthreads > 1)
+  for(size_t i = 0; i < num_elements; i++) { lbuf[i] = rbuf[i]; }
 }
 
 template<typename TL, typename TR>
@@ -184,7 +194,13 @@ void flat_assign(BlockSpan<TL>& lhs, TL scale, const BlockSpan<TR>& rhs) {
   TL*          lbuf         = lhs.buf();
   const TR*    rbuf         = rhs.buf();
   const size_t num_elements = lhs.num_elements();
-  for(size_t i = 0; i < num_elements; i++) { *lbuf++ = scale * *rbuf++; }
+  if constexpr(std::is_same_v<TL, TR>) {
+    kernels::flat::scale(lbuf, scale, rbuf, num_elements);
+    return;
+  }
+  const int nthreads = internal::kernel_threads(num_elements);
+#pragma omp parallel for schedule(static) num_threads(nthreads) if(nthreads > 1)
+  for(size_t i = 0; i < num_elements; i++) { lbuf[i] = scale * rbuf[i]; }
 }
 
 template<typename TL, typename TR>
@@ -192,7 +208,13 @@ void flat_update(BlockSpan<TL>& lhs, const BlockSpan<TR>& rhs) {
   TL*          lbuf         = lhs.buf();
   const TR*    rbuf         = rhs.buf();
   const size_t num_elements = lhs.num_elements();
-  for(size_t i = 0; i < num_elements; i++) { *lbuf++ += *rbuf++; }
+  if constexpr(std::is_same_v<TL, TR>) {
+    kernels::flat::axpy(lbuf, TL{1}, rbuf, num_elements);
+    return;
+  }
+  const int nthreads = internal::kernel_threads(num_elements);
+#pragma omp parallel for schedule(static) num_threads(nthreads) if(nthreads > 1)
+  for(size_t i = 0; i < num_elements; i++) { lbuf[i] += rbuf[i]; }
 }
 
 template<typename TL, typename TR>
@@ -200,7 +222,13 @@ void flat_update(BlockSpan<TL>& lhs, TL rscale, const BlockSpan<TR>& rhs) {
   TL*          lbuf         = lhs.buf();
   const TR*    rbuf         = rhs.buf();
   const size_t num_elements = lhs.num_elements();
-  for(size_t i = 0; i < num_elements; i++) { *lbuf++ += rscale * *rbuf++; }
+  if constexpr(std::is_same_v<TL, TR>) {
+    kernels::flat::axpy(lbuf, rscale, rbuf, num_elements);
+    return;
+  }
+  const int nthreads = internal::kernel_threads(num_elements);
+#pragma omp parallel for schedule(static) num_threads(nthreads) if(nthreads > 1)
+  for(size_t i = 0; i < num_elements; i++) { lbuf[i] += rscale * rbuf[i]; }
 }
 
 template<typename TL, typename TR>
@@ -208,6 +236,12 @@ void flat_update(TL lscale, BlockSpan<TL>& lhs, TL rscale, const BlockSpan<TR>&
   TL*          lbuf         = lhs.buf();
   const TR*    rbuf         = rhs.buf();
   const size_t num_elements = lhs.num_elements();
+  if constexpr(std::is_same_v<TL, TR>) {
+    kernels::flat::axpby(lbuf, lscale, rscale, rbuf, num_elements);
+    return;
+  }
+  const int nthreads = internal::kernel_threads(num_elements);
+#pragma omp parallel for schedule(static) num_threads(nthreads) if(nthreads > 1)
   for(size_t i = 0; i < num_elements; i++) { lbuf[i] = lscale * lbuf[i] + rscale * rbuf[i]; }
 }
 
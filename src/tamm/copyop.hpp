@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "tamm/errors.hpp"
+#include "tamm/kernels/flat_ops.hpp"
+#include "tamm/labeled_tensor.hpp"
+#include "tamm/op_base.hpp"
+#include "tamm/runtime_engine.hpp"
+#include "tamm/tensor.hpp"
+#include "tamm/types.hpp"
+#include "tamm/utils.hpp"
+#include "tamm/work.hpp"
+
+namespace tamm {
+
+/**
+ * @ingroup operations
+ * @brief Copy operation: every LHS block is set to the RHS block with the same block id.
+ *
+ * Block ids are not translated between the two tensors, so the RHS may be a different tensor
+ * with the same block structure (e.g., another spin block). When both tensors are distributed
+ * the same way over the executing process group, the local buffers are copied as a whole. If
+ * only the LHS is, every rank fetches the RHS blocks for the LHS blocks it owns, one block at a
+ * time, and copies them in place (RHS blocks it owns are read in place). Otherwise the blocks
+ * are copied with get and put.
+ *
+ * @tparam LabeledTensorT
+ */
+template<typename LabeledTensorT>
+class CopyOp: public Op {
+public:
+  using T = typename LabeledTensorT::element_type;
+
+  CopyOp(LabeledTensorT lhs, LabeledTensorT rhs): lhs_{lhs}, rhs_{rhs} {
+    fillin_labels();
+    validate();
+  }
+
+  CopyOp(const CopyOp<LabeledTensorT>&) = default;
+
+  LabeledTensorT lhs() const { return lhs_; }
+
+  LabeledTensorT rhs() const { return rhs_; }
+
+  OpList canonicalize() const override { return OpList{(*this)}; }
+
+  OpType op_type() const override { return OpType::map; }
+
+  /// Every LHS block is set, so a copy into a zero LHS is the copy itself
+  std::shared_ptr<Op> first_write_form() const override {
+    if(internal::is_slicing(lhs_) || lhs_.labels() != rhs_.labels()) return nullptr;
+    return clone();
+  }
+
+  std::shared_ptr<Op> clone() const override {
+    return std::shared_ptr<Op>(new CopyOp<LabeledTensorT>{*this});
+  }
+
+  void execute(ExecutionContext& ec, ExecutionHW hw = ExecutionHW::CPU) override {
+    auto ltensor = lhs_.tensor();
+    auto rtensor = rhs_.tensor();
+
+    T* lhs_buf = internal::local_buf_if_owner(ltensor, ec);
+    if(lhs_buf == nullptr) {
+      copy_blocks_global(ec);
+      return;
+    }
+
+    const T* rhs_buf = internal::local_read_buf_if_owner(rtensor, ec);
+    if(rhs_buf != nullptr && is_flat_copy()) {
+      EXPECTS(rtensor.local_buf_size() == ltensor.local_buf_size());
+      kernels::flat::copy(lhs_buf, rhs_buf, ltensor.local_buf_size());
+      return;
+    }
+    copy_blocks_local(ec, lhs_buf, rhs_buf);
+  }
+
+  TensorBase* writes() const { return lhs_.base_ptr(); }
+
+  TensorBase* accumulates() const { return nullptr; }
+
+  std::vector<TensorBase*> reads() const { return {rhs_.base_ptr()}; }
+
+  bool is_memory_barrier() const { return false; }
+
+protected:
+  /// Check if the two tensors lay out the same blocks at the same local buffer offsets
+  bool is_flat_copy() const {
+    const auto& ltensor = lhs_.tensor();
+    const auto& rtensor = rhs_.tensor();
+    return lhs_.labels() == rhs_.labels() && !internal::is_slicing(lhs_) &&
+           !internal::is_slicing(rhs_) && ltensor.has_spin() == rtensor.has_spin() &&
+           (!ltensor.has_spin() || ltensor.spin_mask() == rtensor.spin_mask()) &&
+           ltensor.distribution() == rtensor.distribution();
+  }
+
+  LabelLoopNest loop_nest() const {
+    IndexLabelVec merged_labels{lhs_.labels()};
+    merged_labels.insert(merged_labels.end(), rhs_.labels().begin(), rhs_.labels().end());
+    return LabelLoopNest{merged_labels};
+  }
+
+  void split_blockid(const IndexVector& itval, IndexVector& lblockid, IndexVector& rblockid) const {
+    const size_t nlhs = lhs_.labels().size();
+    lblockid.assign(itval.begin(), itval.begin() + nlhs);
+    rblockid.assign(itval.begin() + nlhs, itval.begin() + nlhs + rhs_.labels().size());
+  }
+
+  /// Owner-computes copy into the LHS blocks of this rank, in @p lhs_buf
+  void copy_blocks_local(ExecutionContext& ec, T* lhs_buf, const T* rhs_buf) {
+    auto        ltensor = lhs_.tensor();
+    auto        rtensor = rhs_.tensor();
+    const auto& ldist   = ltensor.distribution();
+    const Proc  me      = ec.pg().rank();
+
+    IndexVector    lblockid, rblockid;
+    std::vector<T> rbuf;
+    for(const auto& itval: loop_nest()) {
+      split_blockid(itval, lblockid, rblockid);
+      if(!ltensor.is_non_zero(lblockid)) { continue; }
+
+      auto [lproc, loffset] = ldist.locate(lblockid);
+      if(lproc != me) { continue; }
+
+      const size_t lsize = ltensor.block_size(lblockid);
+      T*           block = lhs_buf + loffset.value();
+      if(!rtensor.is_non_zero(rblockid)) {
+        std::fill_n(block, lsize, T{0});
+        continue;
+      }
+      EXPECTS(rtensor.block_size(rblockid) == lsize);
+
+      const T* rhs_ptr = nullptr;
+      if(rhs_buf != nullptr) {
+        auto [rproc, roffset] = rtensor.distribution().locate(rblockid);
+        if(rproc == me) { rhs_ptr = rhs_buf + roffset.value(); }
+      }
+      if(rhs_ptr == nullptr) {
+        rbuf.resize(lsize);
+        rtensor.get(rblockid, rbuf);
+        rhs_ptr = rbuf.data();
+      }
+      kernels::flat::copy(block, rhs_ptr, lsize);
+    }
+  }
+
+  /// Copy through get and put, for LHS tensors not distributed over the executing process group
+  void copy_blocks_global(ExecutionContext& ec) {
+    auto lambda = [&](const IndexVector& itval) {
+      auto        ltensor = lhs_.tensor();
+      IndexVector lblockid, rblockid;
+      split_blockid(itval, lblockid, rblockid);
+
+      const auto&    rtensor = rhs_.tensor();
+      std::vector<T> buf(rtensor.block_size(rblockid));
+      rtensor.get(rblockid, buf);
+      EXPECTS(ltensor.block_size(lblockid) == buf.size());
+      ltensor.put(lblockid, buf);
+    };
+    auto nest = loop_nest();
+    do_work(ec, nest, lambda);
+  }
+
+  void fillin_labels() {
+    using internal::fillin_tensor_label_from_map;
+    using internal::update_fillin_map;
+    std::map<std::string, Label> str_to_labels;
+    update_fillin_map(str_to_labels, lhs_.str_map(), lhs_.str_labels(), 0);
+    update_fillin_map(str_to_labels, rhs_.str_map(), rhs_.str_labels(), lhs_.str_labels().size());
+    fillin_tensor_label_from_map(lhs_, str_to_labels);
+    fillin_tensor_label_from_map(rhs_, str_to_labels);
+  }
+
+  void validate() {
+    if(lhs_.tensor().base_ptr() == rhs_.tensor().base_ptr()) {
+      std::ostringstream os;
+      os << "[TAMM ERROR] Self assignment is not supported in tensor operations!\n"
+         << __FILE__ << ":L" << __LINE__;
+      tamm_terminate(os.str());
+    }
+  }
+
+  LabeledTensorT lhs_;
+  LabeledTensorT rhs_;
+}; // class CopyOp
+
+} // namespace tamm
@@ -0,0 +1,463 @@
+#pragma once
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tamm/errors.hpp"
+#include "tamm/kernels/flat_ops.hpp"
+#include "tamm/labeled_tensor.hpp"
+#include "tamm/op_base.hpp"
+#include "tamm/tensor.hpp"
+#include "tamm/types.hpp"
+#include "tamm/utils.hpp"
+#include "tamm/work.hpp"
+
+namespace tamm {
+
+/**
+ * @brief Compile-time element-wise expressions over labeled tensors.
+ *
+ * Tensors enter an expression through ewise::expr and are combined with +, -, *, /, unary minus,
+ * scalars and ewise::map. The expression type encodes the whole formula, so evaluating an element
+ * is a chain of inlined arithmetic, without temporaries or indirect calls:
+ *
+ * @code
+ * using ewise::expr;
+ * sch(ewise::assign(z(i, j), expr(a(i, j)) * expr(b(i, j)) + expr(c(i, j)) / expr(d(i, j))));
+ * @endcode
+ */
+namespace ewise {
+
+/// Base of all expression nodes
+struct ExprBase {};
+
+template<typename E>
+constexpr bool is_expr_v = std::is_base_of_v<ExprBase, std::decay_t<E>>;
+
+template<typename S>
+constexpr bool is_scalar_v =
+  std::is_arithmetic_v<std::decay_t<S>> || internal::is_complex_v<std::decay_t<S>>;
+
+/// Leaf reading the element of a tensor; bound to a buffer by EwiseOp before evaluation
+template<typename T>
+class TensorExpr: public ExprBase {
+public:
+  explicit TensorExpr(LabeledTensor<T> lt): lt_{lt} {}
+
+  TAMM_FLAT_INLINE T eval(size_t i) const { return data_[i]; }
+
+  template<typename Func>
+  void for_each_leaf(Func&& func) {
+    func(*this);
+  }
+
+  template<typename Func>
+  void for_each_leaf(Func&& func) const {
+    func(*this);
+  }
+
+  LabeledTensor<T>&       labeled_tensor() { return lt_; }
+  const LabeledTensor<T>& labeled_tensor() const { return lt_; }
+
+  /// Look up the local buffer of the tensor, if it is distributed over the process group of @p ec
+  void bind_local(const ExecutionContext& ec) {
+    local_buf_ = internal::local_read_buf_if_owner(lt_.tensor(), ec);
+  }
+
+  bool has_local_buf() const { return local_buf_ != nullptr; }
+
+  /// Read the local buffer as a whole
+  void bind_flat() { data_ = local_buf_; }
+
+  /// Read block @p blockid of @p size elements: in place if this rank owns it, else from a copy
+  void bind_block(const IndexVector& blockid, size_t size, Proc me) {
+    auto tensor = lt_.tensor();
+    if(!tensor.is_non_zero(blockid)) {
+      stage_.assign(size, T{0});
+      data_ = stage_.data();
+      return;
+    }
+    EXPECTS(tensor.block_size(blockid) == size);
+    if(local_buf_ != nullptr) {
+      auto [proc, offset] = tensor.distribution().locate(blockid);
+      if(proc == me) {
+        data_ = local_buf_ + offset.value();
+        return;
+      }
+    }
+    stage_.resize(size);
+    tensor.get(blockid, stage_);
+    data_ = stage_.data();
+  }
+
+private:
+  LabeledTensor<T> lt_;
+  const T*         data_      = nullptr;
+  const T*         local_buf_ = nullptr;
+  std::vector<T>   stage_;
+};
+
+/// Scalar operand
+template<typename S>
+class ScalarExpr: public ExprBase {
+public:
+  explicit ScalarExpr(S value): value_{value} {}
+
+  TAMM_FLAT_INLINE S eval(size_t) const { return value_; }
+
+  template<typename Func>
+  void for_each_leaf(Func&&) {}
+
+  template<typename Func>
+  void for_each_leaf(Func&&) const {}
+
+private:
+  S value_;
+};
+
+struct Plus {
+  template<typename A, typename B>
+  TAMM_FLAT_INLINE static auto apply(const A& a, const B& b) {
+    return a + b;
+  }
+};
+
+struct Minus {
+  template<typename A, typename B>
+  TAMM_FLAT_INLINE static auto apply(const A& a, const B& b) {
+    return a - b;
+  }
+};
+
+struct Multiplies {
+  template<typename A, typename B>
+  TAMM_FLAT_INLINE static auto apply(const A& a, const B& b) {
+    return a * b;
+  }
+};
+
+struct Divides {
+  template<typename A, typename B>
+  TAMM_FLAT_INLINE static auto apply(const A& a, const B& b) {
+    return a / b;
+  }
+};
+
+struct Negate {
+  template<typename A>
+  TAMM_FLAT_INLINE auto operator()(const A& a) const {
+    return -a;
+  }
+};
+
+/// l (BinOp) r
+template<typename BinOp, typename L, typename R>
+class BinaryExpr: public ExprBase {
+public:
+  BinaryExpr(L l, R r): l_{std::move(l)}, r_{std::move(r)} {}
+
+  TAMM_FLAT_INLINE auto eval(size_t i) const { return BinOp::apply(l_.eval(i), r_.eval(i)); }
+
+  template<typename Func>
+  void for_each_leaf(Func&& func) {
+    l_.for_each_leaf(func);
+    r_.for_each_leaf(func);
+  }
+
+  template<typename Func>
+  void for_each_leaf(Func&& func) const {
+    l_.for_each_leaf(func);
+    r_.for_each_leaf(func);
+  }
+
+private:
+  L l_;
+  R r_;
+};
+
+/// func(e), with the functor type part of the expression so it is inlined
+template<typename Func, typename E>
+class UnaryExpr: public ExprBase {
+public:
+  UnaryExpr(Func func, E e): func_{std::move(func)}, e_{std::move(e)} {}
+
+  TAMM_FLAT_INLINE auto eval(size_t i) const { return func_(e_.eval(i)); }
+
+  template<typename LeafFunc>
+  void for_each_leaf(LeafFunc&& func) {
+    e_.for_each_leaf(func);
+  }
+
+  template<typename LeafFunc>
+  void for_each_leaf(LeafFunc&& func) const {
+    e_.for_each_leaf(func);
+  }
+
+private:
+  Func func_;
+  E    e_;
+};
+
+/// Leaf for labeled tensor @p lt
+template<typename T>
+TensorExpr<T> expr(LabeledTensor<T> lt) {
+  return TensorExpr<T>{lt};
+}
+
+/// Apply @p func to every element of @p e
+template<typename E, typename Func, typename = std::enable_if_t<is_expr_v<E>>>
+auto map(E e, Func func) {
+  return UnaryExpr<Func, E>{std::move(func), std::move(e)};
+}
+
+namespace detail {
+
+template<typename E>
+auto as_expr(E e) {
+  if constexpr(is_expr_v<E>) return e;
+  else return ScalarExpr<E>{e};
+}
+
+// An expression combined with another expression or a scalar
+template<typename L, typename R>
+constexpr bool is_operand_pair_v = (is_expr_v<L> && (is_expr_v<R> || is_scalar_v<R>)) ||
+                                   (is_scalar_v<L> && is_expr_v<R>);
+
+template<typename BinOp, typename L, typename R>
+auto make_binary(L l, R r) {
+  auto le = as_expr(std::move(l));
+  auto re = as_expr(std::move(r));
+  return BinaryExpr<BinOp, decltype(le), decltype(re)>{std::move(le), std::move(re)};
+}
+
+} // namespace detail
+
+template<typename L, typename R, typename = std::enable_if_t<detail::is_operand_pair_v<L, R>>>
+auto operator+(L l, R r) {
+  return detail::make_binary<Plus>(std::move(l), std::move(r));
+}
+
+template<typename L, typename R, typename = std::enable_if_t<detail::is_operand_pair_v<L, R>>>
+auto operator-(L l, R r) {
+  return detail::make_binary<Minus>(std::move(l), std::move(r));
+}
+
+template<typename L, typename R, typename = std::enable_if_t<detail::is_operand_pair_v<L, R>>>
+auto operator*(L l, R r) {
+  return detail::make_binary<Multiplies>(std::move(l), std::move(r));
+}
+
+template<typename L, typename R, typename = std::enable_if_t<detail::is_operand_pair_v<L, R>>>
+auto operator/(L l, R r) {
+  return detail::make_binary<Divides>(std::move(l), std::move(r));
+}
+
+template<typename E, typename = std::enable_if_t<is_expr_v<E>>>
+auto operator-(E e) {
+  return UnaryExpr<Negate, E>{Negate{}, std::move(e)};
+}
+
+} // namespace ewise
+
+/**
+ * @ingroup operations
+ * @brief Element-wise operation: the LHS is set to (or updated with) an ewise expression.
+ *
+ * Every tensor in the expression must carry the LHS labels, without slicing. When all of them are
+ * distributed like the LHS over the executing process group, each rank evaluates the expression
+ * in one pass over its local buffers. Otherwise every rank visits the LHS blocks it owns and
+ * evaluates them block by block, reading the operand blocks in place when it owns them and
+ * fetching them otherwise.
+ *
+ * @tparam T element type of the LHS tensor
+ * @tparam E expression type
+ */
+template<typename T, typename E>
+class EwiseOp: public Op {
+public:
+  EwiseOp(LabeledTensor<T> lhs, E expr, bool is_assign):
+    lhs_{lhs}, expr_{std::move(expr)}, is_assign_{is_assign} {
+    fillin_labels();
+    validate();
+  }
+
+  EwiseOp(const EwiseOp<T, E>&) = default;
+
+  LabeledTensor<T> lhs() const { return lhs_; }
+
+  bool is_assign() const { return is_assign_; }
+
+  OpList canonicalize() const override { return OpList{(*this)}; }
+
+  OpType op_type() const override { return OpType::map; }
+
+  /// Every LHS block is written, so an update of a zero LHS is an assignment
+  std::shared_ptr<Op> first_write_form() const override {
+    auto op        = std::make_shared<EwiseOp<T, E>>(*this);
+    op->is_assign_ = true;
+    return op;
+  }
+
+  std::shared_ptr<Op> clone() const override {
+    return std::shared_ptr<Op>(new EwiseOp<T, E>{*this});
+  }
+
+  void execute(ExecutionContext& ec, ExecutionHW hw = ExecutionHW::CPU) override {
+    auto ltensor = lhs_.tensor();
+
+    bool is_flat = true;
+    expr_.for_each_leaf([&](auto& leaf) {
+      leaf.bind_local(ec);
+      is_flat = is_flat && leaf.has_local_buf() && has_lhs_layout(leaf.labeled_tensor().tensor());
+    });
+
+    T* lhs_buf = internal::local_buf_if_owner(ltensor, ec);
+    if(lhs_buf == nullptr) {
+      eval_blocks_global(ec);
+      return;
+    }
+    if(is_flat) {
+      expr_.for_each_leaf([](auto& leaf) { leaf.bind_flat(); });
+      eval_flat(lhs_buf, ltensor.local_buf_size());
+      return;
+    }
+    eval_blocks_local(ec, lhs_buf);
+  }
+
+  TensorBase* writes() const {
+    if(is_assign_) { return lhs_.base_ptr(); }
+    else { return nullptr; }
+  }
+
+  TensorBase* accumulates() const {
+    if(!is_assign_) { return lhs_.base_ptr(); }
+    else { return nullptr; }
+  }
+
+  std::vector<TensorBase*> reads() const {
+    std::vector<TensorBase*> res;
+    expr_.for_each_leaf([&](const auto& leaf) { res.push_back(leaf.labeled_tensor().base_ptr()); });
+    return res;
+  }
+
+  bool is_memory_barrier() const { return false; }
+
+protected:
+  /// Check if @p tensor lays out the same blocks as the LHS at the same local buffer offsets
+  template<typename T2>
+  bool has_lhs_layout(const Tensor<T2>& tensor) const {
+    const auto& ltensor = lhs_.tensor();
+    return ltensor.has_spin() == tensor.has_spin() &&
+           (!ltensor.has_spin() || ltensor.spin_mask() == tensor.spin_mask()) &&
+           ltensor.distribution() == tensor.distribution() &&
+           ltensor.local_buf_size() == tensor.local_buf_size();
+  }
+
+  /// out[i] = e(i) or out[i] += e(i) over [0, n), with the leaves bound
+  void eval_flat(T* out, size_t n) const {
+    const E& e = expr_;
+    if(is_assign_) {
+      kernels::flat::detail::run(kernels::flat::simd_isa(), n,
+                                 [out, &e](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+                                   for(size_t i = lo; i < hi; i++) out[i] = e.eval(i);
+                                 });
+    }
+    else {
+      kernels::flat::detail::run(kernels::flat::simd_isa(), n,
+                                 [out, &e](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+                                   for(size_t i = lo; i < hi; i++) out[i] += e.eval(i);
+                                 });
+    }
+  }
+
+  /// Owner-computes evaluation of the LHS blocks of this rank, in @p lhs_buf
+  void eval_blocks_local(ExecutionContext& ec, T* lhs_buf) {
+    auto        ltensor = lhs_.tensor();
+    const auto& ldist   = ltensor.distribution();
+    const Proc  me      = ec.pg().rank();
+
+    LabelLoopNest loop_nest{lhs_.labels()};
+    for(const IndexVector& blockid: loop_nest) {
+      if(!ltensor.is_non_zero(blockid)) { continue; }
+
+      auto [lproc, loffset] = ldist.locate(blockid);
+      if(lproc != me) { continue; }
+
+      const size_t size = ltensor.block_size(blockid);
+      expr_.for_each_leaf([&](auto& leaf) { leaf.bind_block(blockid, size, me); });
+      eval_flat(lhs_buf + loffset.value(), size);
+    }
+  }
+
+  /// Evaluation through get and put, for LHS tensors not distributed over the executing process
+  /// group
+  void eval_blocks_global(ExecutionContext& ec) {
+    const Proc    me = ec.pg().rank();
+    LabelLoopNest loop_nest{lhs_.labels()};
+    auto          lambda = [&](const IndexVector& blockid) {
+      auto ltensor = lhs_.tensor();
+      if(!ltensor.is_non_zero(blockid)) { return; }
+
+      const size_t   size = ltensor.block_size(blockid);
+      std::vector<T> buf(size);
+      if(!is_assign_) { ltensor.get(blockid, buf); }
+      expr_.for_each_leaf([&](auto& leaf) { leaf.bind_block(blockid, size, me); });
+      eval_flat(buf.data(), size);
+      ltensor.put(blockid, buf);
+    };
+    do_work(ec, loop_nest, lambda);
+  }
+
+  void fillin_labels() {
+    using internal::fillin_tensor_label_from_map;
+    using internal::update_fillin_map;
+    std::map<std::string, Label> str_to_labels;
+    size_t                       off = lhs_.str_labels().size();
+    update_fillin_map(str_to_labels, lhs_.str_map(), lhs_.str_labels(), 0);
+    expr_.for_each_leaf([&](auto& leaf) {
+      const auto& lt = leaf.labeled_tensor();
+      update_fillin_map(str_to_labels, lt.str_map(), lt.str_labels(), off);
+      off += lt.str_labels().size();
+    });
+    fillin_tensor_label_from_map(lhs_, str_to_labels);
+    expr_.for_each_leaf(
+      [&](auto& leaf) { fillin_tensor_label_from_map(leaf.labeled_tensor(), str_to_labels); });
+  }
+
+  /// Every operand block has the block id of the LHS block it contributes to
+  void validate() {
+    EXPECTS(!internal::is_slicing(lhs_));
+    expr_.for_each_leaf([&](const auto& leaf) {
+      EXPECTS(leaf.labeled_tensor().labels() == lhs_.labels());
+      EXPECTS(!internal::is_slicing(leaf.labeled_tensor()));
+    });
+  }
+
+  LabeledTensor<T> lhs_;
+  E                expr_;
+  bool             is_assign_;
+}; // class EwiseOp
+
+namespace ewise {
+
+/// lhs = e
+template<typename T, typename E, typename = std::enable_if_t<is_expr_v<E>>>
+EwiseOp<T, E> assign(LabeledTensor<T> lhs, E e) {
+  return EwiseOp<T, E>{lhs, std::move(e), true};
+}
+
+/// lhs += e
+template<typename T, typename E, typename = std::enable_if_t<is_expr_v<E>>>
+EwiseOp<T, E> update(LabeledTensor<T> lhs, E e) {
+  return EwiseOp<T, E>{lhs, std::move(e), false};
+}
+
+} // namespace ewise
+
+} // namespace tamm
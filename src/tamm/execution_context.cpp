@@ -1,5 +1,9 @@
 #include "ga/ga.h"
 #include <mpi.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#include <thread>
 
 #include "distribution.hpp"
 #include "execution_context.hpp"
@@ -41,6 +45,19 @@ ExecutionContext::ExecutionContext(ProcGroup pg, DistributionKind default_dist_k
   nnodes_  = pg.size().value() / ranks_pn_;
   gpus_pn_ = ranks_pn_ / ranks_per_gpu_pool();
 
+  if(detail::tamm_kernel_threads > 0) kernel_threads_ = detail::tamm_kernel_threads;
+  else {
+    const int ncores = static_cast<int>(std::thread::hardware_concurrency());
+    int       navail = ncores;
+#if defined(__linux__)
+    cpu_set_t cpuset;
+    if(sched_getaffinity(0, sizeof(cpuset), &cpuset) == 0) navail = CPU_COUNT(&cpuset);
+#endif
+    // ranks that are not bound to cores share the cores of the node
+    if(navail >= ncores) navail = ncores / ranks_pn_;
+    kernel_threads_ = std::max(navail, 1);
+  }
+
 #if defined(__APPLE__)
   {
     size_t size_mpn = sizeof(minfo_.cpu_mem_per_node);
@@ -16,6 +16,7 @@
 #include <sys/sysinfo.h>
 #endif
 
+#include <cstdlib>
 #include <cstring>
 #if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
 #include "tamm/gpu_streams.hpp"
@@ -33,6 +34,18 @@ extern upcxx::team* team_self;
 
 namespace tamm {
 
+namespace detail {
+// TAMM_KERNEL_THREADS = 0(default, cores available per rank)
+// Threads used by block transposes and element-wise block kernels.
+static const int tamm_kernel_threads = [] {
+  int kernel_threads = 0;
+  if(const char* tammKernelThreads = std::getenv("TAMM_KERNEL_THREADS")) {
+    kernel_threads = std::atoi(tammKernelThreads);
+  }
+  return kernel_threads;
+}();
+} // namespace detail
+
 inline std::string getHostName() {
 #if defined(__APPLE__)
   char   buffer[64]; /* Should be long enough! */
@@ -344,6 +357,13 @@ public:
   int ppn() const { return ranks_pn_; }
   int gpn() const { return gpus_pn_; }
 
+  /// Threads used by block transposes and element-wise block kernels on this rank
+  int  kernel_threads() const { return kernel_threads_; }
+  void set_kernel_threads(int nthreads) {
+    EXPECTS(nthreads > 0);
+    kernel_threads_ = nthreads;
+  }
+
   struct meminfo {
     size_t      gpu_mem_per_device; // single gpu mem per rank (GiB)
     size_t      gpu_mem_per_node;   // total gpu mem per node (GiB)
@@ -438,6 +458,7 @@ private:
   int                            nnodes_;
   int                            ranks_pn_;
   int                            gpus_pn_{0};
+  int                            kernel_threads_{1};
   bool                           has_gpu_{false};
   ExecutionHW                    exhw_{ExecutionHW::CPU};
   meminfo                        minfo_;
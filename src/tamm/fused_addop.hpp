@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "tamm/block_assign_plan.hpp"
+#include "tamm/errors.hpp"
+#include "tamm/label_translator.hpp"
+#include "tamm/labeled_tensor.hpp"
+#include "tamm/op_base.hpp"
+#include "tamm/scalar.hpp"
+#include "tamm/types.hpp"
+#include "tamm/utils.hpp"
+
+namespace tamm {
+
+namespace internal {
+
+/// One `lhs += alpha * rhs` term of a fused add
+template<typename LabeledTensorT1, typename LabeledTensorT2>
+struct AddTerm {
+  LabeledTensorT1     lhs;
+  Scalar              alpha;
+  LabeledTensorT2     rhs;
+  std::shared_ptr<Op> op; //< the AddOp of the term, run on its own when the fused path is not used
+};
+
+/**
+ * @brief Check if `lhs += alpha * rhs` can be part of a fused add: a full (non-sliced) update of
+ * an LHS that owns its buffer, from a RHS whose labels are a permutation of the LHS labels.
+ */
+template<typename LabeledTensorT1, typename LabeledTensorT2>
+bool is_fusable_add(const LabeledTensorT1& lhs, const LabeledTensorT2& rhs) {
+  using TensorKind = TensorBase::TensorKind;
+
+  const auto lkind = lhs.tensor().kind();
+  const auto rkind = rhs.tensor().kind();
+  return lkind != TensorKind::view && lkind != TensorKind::unit_view &&
+         lkind != TensorKind::dense && lkind != TensorKind::lambda && rkind != TensorKind::view &&
+         rkind != TensorKind::unit_view && rkind != TensorKind::lambda && !is_slicing(lhs) &&
+         !is_slicing(rhs) && !has_duplicates(lhs.labels()) &&
+         lhs.labels().size() == rhs.labels().size() &&
+         std::is_permutation(lhs.labels().begin(), lhs.labels().end(), rhs.labels().begin()) &&
+         lhs.tensor().has_spin() == rhs.tensor().has_spin();
+}
+
+} // namespace internal
+
+template<typename LabeledTensorT1, typename LabeledTensorT2>
+class FusedAddOp;
+
+/**
+ * @brief Base of the add operations on a given pair of LHS and RHS tensor types. Consecutive
+ * accumulates into the same LHS are fused into a FusedAddOp, whatever their scaling factor type.
+ */
+template<typename LabeledTensorT1, typename LabeledTensorT2>
+class FusableAddOp: public Op {
+public:
+  using AddTermT = internal::AddTerm<LabeledTensorT1, LabeledTensorT2>;
+
+  /// Terms of this op, or none if it cannot be fused
+  virtual std::vector<AddTermT> add_terms() const = 0;
+
+  std::shared_ptr<Op> fuse(const Op& next) const override;
+};
+
+/**
+ * @brief Sum of several add operations into the same LHS: `lhs += a1 * rhs1 + a2 * rhs2 + ...`,
+ * where each RHS may permute the LHS labels.
+ *
+ * The LHS blocks are read and written once for all terms: when the LHS is distributed over the
+ * executing process group, every rank updates its own LHS blocks in place with each term in
+ * turn. If every RHS has the same labels and distribution as the LHS, the terms are applied
+ * while streaming through the local buffers in cache-sized chunks. On other process groups the
+ * terms run one after the other as separate add operations.
+ *
+ * The scheduler builds these ops by merging consecutive AddOps on the same LHS
+ * (TAMM_FUSE_ADD_OPS).
+ */
+template<typename LabeledTensorT1, typename LabeledTensorT2>
+class FusedAddOp: public FusableAddOp<LabeledTensorT1, LabeledTensorT2> {
+public:
+  using AddTermT = internal::AddTerm<LabeledTensorT1, LabeledTensorT2>;
+
+  /// Number of elements per chunk when streaming through flat local buffers
+  static constexpr size_t flat_chunk_size = 4096;
+
+  FusedAddOp(std::vector<AddTermT> terms): terms_{std::move(terms)} {
+    EXPECTS(terms_.size() >= 2);
+    for(const auto& term: terms_) {
+      EXPECTS(term.lhs.base_ptr() == terms_[0].lhs.base_ptr());
+      EXPECTS(term.lhs.labels() == terms_[0].lhs.labels());
+      EXPECTS(internal::is_fusable_add(term.lhs, term.rhs));
+    }
+  }
+
+  FusedAddOp(const FusedAddOp<LabeledTensorT1, LabeledTensorT2>&) = default;
+
+  LabeledTensorT1 lhs() const { return terms_[0].lhs; }
+
+  size_t num_terms() const { return terms_.size(); }
+
+  std::vector<AddTermT> add_terms() const override { return terms_; }
+
+  /// Same sum with the first term assigned to the LHS instead of added to it
+  std::shared_ptr<Op> first_write_form() const override {
+    auto first_op = terms_[0].op->first_write_form();
+    if(first_op == nullptr) return nullptr;
+    auto op                = std::make_shared<FusedAddOp<LabeledTensorT1, LabeledTensorT2>>(*this);
+    op->terms_[0].op       = first_op;
+    op->assign_first_term_ = true;
+    return op;
+  }
+
+  OpType op_type() const override { return OpType::add; }
+
+  OpList canonicalize() const override { return OpList{(*this)}; }
+
+  std::shared_ptr<Op> clone() const override {
+    return std::shared_ptr<Op>(new FusedAddOp<LabeledTensorT1, LabeledTensorT2>{*this});
+  }
+
+  void execute(ExecutionContext& ec, ExecutionHW hw = ExecutionHW::CPU) override {
+    const auto& ltensor = terms_[0].lhs.tensor();
+    EXPECTS(ltensor.execution_context() != nullptr);
+
+    if(ltensor.execution_context()->pg() != ec.pg()) {
+      // each term distributes its own work
+      auto ac = ec.ac();
+      ec.set_ac(IndexedAC(nullptr, 0));
+      for(auto& term: terms_) { term.op->execute(ec, hw); }
+      ec.set_ac(ac);
+      return;
+    }
+
+    std::vector<const AddTermT*> terms;
+    bool                         all_flat = true;
+    for(const auto& term: terms_) {
+      const auto& rtensor = term.rhs.tensor();
+      if(term.rhs.labels() != term.lhs.labels() ||
+         rtensor.execution_context()->pg() != ltensor.execution_context()->pg() ||
+         !(rtensor.distribution() == ltensor.distribution())) {
+        all_flat = false;
+      }
+      terms.push_back(&term);
+    }
+    if(all_flat) { apply_flat(terms); }
+    else { apply_blocks(ec, terms); }
+  }
+
+  TensorBase* writes() const { return nullptr; }
+
+  TensorBase* accumulates() const { return terms_[0].lhs.base_ptr(); }
+
+  std::vector<TensorBase*> reads() const {
+    std::vector<TensorBase*> res;
+    for(const auto& term: terms_) res.push_back(term.rhs.base_ptr());
+    return res;
+  }
+
+  bool is_memory_barrier() const { return false; }
+
+protected:
+  using T1 = typename LabeledTensorT1::element_type;
+  using T2 = typename LabeledTensorT2::element_type;
+
+  /// lhs += sum of the terms over the flat local buffers, one chunk at a time
+  void apply_flat(const std::vector<const AddTermT*>& terms) {
+    auto         ltensor  = terms_[0].lhs.tensor();
+    T1*          lhs_buf  = ltensor.access_local_buf();
+    const size_t lhs_size = ltensor.local_buf_size();
+
+    std::vector<const T2*>       rhs_bufs;
+    std::vector<BlockAssignPlan> plans;
+    for(const auto* term: terms) {
+      const Tensor<T2> rtensor = term->rhs.tensor();
+      EXPECTS(rtensor.local_buf_size() == lhs_size);
+      rhs_bufs.push_back(rtensor.access_local_buf());
+      plans.emplace_back(term->lhs.labels(), term->rhs.labels(), term_optype(plans.size()));
+    }
+
+    const size_t nchunks  = (lhs_size + flat_chunk_size - 1) / flat_chunk_size;
+    const int    nthreads = std::min<int>(internal::kernel_threads(lhs_size), nchunks);
+#pragma omp parallel num_threads(nthreads) if(nthreads > 1)
+    {
+      auto thread_plans = plans;
+#pragma omp for schedule(static)
+      for(size_t c = 0; c < nchunks; c++) {
+        const size_t lo = c * flat_chunk_size;
+        const size_t n  = std::min(flat_chunk_size, lhs_size - lo);
+
+        BlockSpan<T1> lhs_span{lhs_buf + lo, {n}};
+        for(size_t t = 0; t < terms.size(); t++) {
+          BlockSpan<T2> rhs_span{const_cast<T2*>(rhs_bufs[t]) + lo, {n}};
+          thread_plans[t].apply(lhs_span, terms[t]->alpha, rhs_span);
+        }
+      }
+    }
+  }
+
+  /// lhs += sum of the terms, block by block over the LHS blocks owned by this rank
+  void apply_blocks(ExecutionContext& ec, const std::vector<const AddTermT*>& terms) {
+    const auto& lhs_lt    = terms_[0].lhs;
+    auto        ltensor   = lhs_lt.tensor();
+    const auto& ldist     = ltensor.distribution();
+    const Proc  me        = ec.pg().rank();
+    T1*         local_buf = ltensor.access_local_buf();
+
+    // position in the LHS labels of each RHS label, per term
+    std::vector<std::vector<size_t>>       rhs_pos;
+    std::vector<internal::LabelTranslator> rhs_translators;
+    std::vector<BlockAssignPlan>           plans;
+    std::vector<const T2*>                 rhs_local_bufs;
+    for(const auto* term: terms) {
+      std::vector<size_t> pos;
+      for(const auto& rlbl: term->rhs.labels()) {
+        pos.push_back(std::find(lhs_lt.labels().begin(), lhs_lt.labels().end(), rlbl) -
+                      lhs_lt.labels().begin());
+      }
+      rhs_pos.push_back(pos);
+      rhs_translators.emplace_back(term->rhs.labels(), term->rhs.tensor()().labels());
+      plans.emplace_back(lhs_lt.labels(), term->rhs.labels(), term_optype(plans.size()));
+      rhs_local_bufs.push_back(internal::local_read_buf_if_owner(term->rhs.tensor(), ec));
+    }
+
+    internal::LabelTranslator translator{lhs_lt.labels(), ltensor().labels()};
+    LabelLoopNest             loop_nest{lhs_lt.labels()};
+    std::vector<T2>           rhs_buf;
+    for(const auto& blockid: loop_nest) {
+      auto [l_blockid, l_valid] = translator.apply(blockid);
+      if(!l_valid || !ltensor.is_non_zero(l_blockid)) { continue; }
+
+      auto [lhs_proc, lhs_offset] = ldist.locate(l_blockid);
+      if(lhs_proc != me) { continue; }
+
+      BlockSpan<T1> lhs_span{local_buf + lhs_offset.value(), ltensor.block_dims(l_blockid)};
+      for(size_t t = 0; t < terms.size(); t++) {
+        auto        rtensor = terms[t]->rhs.tensor();
+        IndexVector r_use_blockid(rhs_pos[t].size());
+        for(size_t i = 0; i < rhs_pos[t].size(); i++) r_use_blockid[i] = blockid[rhs_pos[t][i]];
+
+        auto [r_blockid, r_valid] = rhs_translators[t].apply(r_use_blockid);
+        if(!r_valid || !rtensor.is_non_zero(r_blockid)) {
+          if(t == 0 && assign_first_term_) {
+            std::fill_n(lhs_span.buf(), lhs_span.num_elements(), T1{0});
+          }
+          continue;
+        }
+
+        const T2* rhs_ptr = nullptr;
+        if(rhs_local_bufs[t] != nullptr) {
+          auto [rhs_proc, rhs_offset] = rtensor.distribution().locate(r_blockid);
+          if(rhs_proc == me) { rhs_ptr = rhs_local_bufs[t] + rhs_offset.value(); }
+        }
+        if(rhs_ptr == nullptr) {
+          rhs_buf.resize(rtensor.block_size(r_blockid));
+          rtensor.get(r_blockid, rhs_buf);
+          rhs_ptr = rhs_buf.data();
+        }
+        BlockSpan<T2> rhs_span{const_cast<T2*>(rhs_ptr), rtensor.block_dims(r_blockid)};
+        plans[t].apply(lhs_span, terms[t]->alpha, rhs_span);
+      }
+    }
+  }
+
+  BlockAssignPlan::OpType term_optype(size_t t) const {
+    return t == 0 && assign_first_term_ ? BlockAssignPlan::OpType::set
+                                        : BlockAssignPlan::OpType::update;
+  }
+
+  std::vector<AddTermT> terms_;
+  bool                  assign_first_term_{false};
+}; // class FusedAddOp
+
+template<typename LabeledTensorT1, typename LabeledTensorT2>
+std::shared_ptr<Op> FusableAddOp<LabeledTensorT1, LabeledTensorT2>::fuse(const Op& next) const {
+  const auto* next_add = dynamic_cast<const FusableAddOp<LabeledTensorT1, LabeledTensorT2>*>(&next);
+  if(next_add == nullptr || next.exhw_ != this->exhw_) return nullptr;
+
+  auto terms      = add_terms();
+  auto next_terms = next_add->add_terms();
+  if(terms.empty() || next_terms.empty()) return nullptr;
+  if(terms[0].lhs.base_ptr() != next_terms[0].lhs.base_ptr() ||
+     terms[0].lhs.labels() != next_terms[0].lhs.labels()) {
+    return nullptr;
+  }
+
+  terms.insert(terms.end(), next_terms.begin(), next_terms.end());
+  auto fused    = std::make_shared<FusedAddOp<LabeledTensorT1, LabeledTensorT2>>(std::move(terms));
+  fused->exhw_  = this->exhw_;
+  fused->opstr_ = next.opstr_.empty() ? this->opstr_ : this->opstr_ + "; " + next.opstr_;
+  return fused;
+}
+
+} // namespace tamm
@@ -4,6 +4,7 @@
 
 #include "hptt/hptt.h"
 #include "tamm/errors.hpp"
+#include "tamm/kernels/hptt_plan_cache.hpp"
 #include "tamm/types.hpp"
 
 namespace tamm::blockops::hptt {
@@ -45,16 +46,16 @@ void index_permute_hptt(T lscale, T* lbuf, T rscale, const T* rbuf, const PermVe
   const int ndim = sdims.size();
   int       perm[ndim];
   int       size[ndim];
-  int       num_threads = 1;
-  for(size_t i = 0; i < sdims.size(); i++) { size[i] = sdims[i]; }
+  size_t    nelements = 1;
+  for(size_t i = 0; i < sdims.size(); i++) {
+    size[i] = sdims[i];
+    nelements *= sdims[i];
+  }
+  const int num_threads = internal::kernel_threads(nelements);
 
   for(size_t i = 0; i < perm_to_dest.size(); i++) { perm[i] = perm_to_dest[i]; }
-  // create a plan (shared_ptr)
-  auto plan = ::hptt::create_plan(perm, ndim, rscale, rbuf, size, NULL, lscale, lbuf, NULL,
-                                  ::hptt::ESTIMATE, num_threads, NULL, true);
-
-  // execute the transposition
-  plan->execute();
+  internal::HPTTPlanCache::instance().transpose(perm, ndim, rscale, rbuf, size, lscale, lbuf,
+                                                num_threads);
 }
 
 } // namespace tamm::blockops::hptt
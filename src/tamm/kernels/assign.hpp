@@ -1,178 +1,169 @@
 #pragma once
 
 #include "tamm/errors.hpp"
+#include "tamm/kernels/flat_ops.hpp"
+#include "tamm/kernels/hptt_plan_cache.hpp"
 #include "tamm/types.hpp"
 #include "tamm/utils.hpp"
 
 #include "hptt/hptt.h"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 namespace tamm {
 
 namespace internal {
 
-template<typename T>
-void ip0(const SizeVec& /*loop_dims*/, T* dst, const SizeVec& /*loop_dld*/, T scale, const T* src,
-         const SizeVec& /*loop_sld*/) {
-  dst[0] = scale * src[0];
-}
+/// Max rank handled by the strided permute kernels
+constexpr size_t ip_max_rank = 8;
+/// Smaller permutations use the strided kernels, where HPTT's setup dominates
+constexpr size_t ip_hptt_min_elements = 1024;
 
-template<typename T>
-void ip1(const SizeVec& loop_dims, T* dst, const SizeVec& loop_dld, T scale, const T* src,
-         const SizeVec& loop_sld) {
-  const size_t ndim = 1;
-  Size         soff[ndim], doff[ndim];
-  size_t       i[ndim];
-
-  for(i[0] = 0, soff[0] = 0, doff[0] = 0; i[0] < loop_dims[0];
-      i[0]++, soff[0] += loop_sld[0], doff[0] += loop_dld[0]) {
-    dst[doff[0].value()] = scale * src[soff[0].value()];
+/**
+ * @brief Strided permute/accumulate over @p N nested loops: loop d runs over dims[d] and steps
+ * dst by dld[d] and src by sld[d]. The recursion is resolved at compile time, so every rank gets
+ * its own fully nested loop, and a unit-stride innermost loop is a plain vectorizable loop.
+ */
+template<size_t N, bool Acc, typename T>
+void ip_strided(const size_t* dims, T* dst, const size_t* dld, T scale, const T* src,
+                const size_t* sld) {
+  if constexpr(N == 0) {
+    if constexpr(Acc) dst[0] += scale * src[0];
+    else dst[0] = scale * src[0];
   }
-}
-
-template<typename T>
-void ip2(const SizeVec& loop_dims, T* dst, const SizeVec& loop_dld, T scale, const T* src,
-         const SizeVec& loop_sld) {
-  const size_t ndim = 2;
-  Size         soff[ndim], doff[ndim];
-  size_t       i[ndim];
-
-  for(i[0] = 0, soff[0] = 0, doff[0] = 0; i[0] < loop_dims[0];
-      i[0]++, soff[0] += loop_sld[0], doff[0] += loop_dld[0]) {
-    for(i[1] = 0, soff[1] = soff[0], doff[1] = doff[0]; i[1] < loop_dims[1];
-        i[1]++, soff[1] += loop_sld[1], doff[1] += loop_dld[1]) {
-      dst[doff[1].value()] = scale * src[soff[1].value()];
+  else if constexpr(N == 1) {
+    const size_t n = dims[0];
+    if(dld[0] == 1 && sld[0] == 1) {
+      if constexpr(Acc) {
+        for(size_t i = 0; i < n; i++) dst[i] += scale * src[i];
+      }
+      else {
+        for(size_t i = 0; i < n; i++) dst[i] = scale * src[i];
+      }
     }
-  }
-}
-
-template<typename T>
-void ip3(const SizeVec& loop_dims, T* dst, const SizeVec& loop_dld, T scale, const T* src,
-         const SizeVec& loop_sld) {
-  const size_t ndim = 3;
-  Size         soff[ndim], doff[ndim];
-  size_t       i[ndim];
-
-  for(i[0] = 0, soff[0] = 0, doff[0] = 0; i[0] < loop_dims[0];
-      i[0]++, soff[0] += loop_sld[0], doff[0] += loop_dld[0]) {
-    for(i[1] = 0, soff[1] = soff[0], doff[1] = doff[0]; i[1] < loop_dims[1];
-        i[1]++, soff[1] += loop_sld[1], doff[1] += loop_dld[1]) {
-      for(i[2] = 0, soff[2] = soff[1], doff[2] = doff[1]; i[2] < loop_dims[2];
-          i[2]++, soff[2] += loop_sld[2], doff[2] += loop_dld[2]) {
-        dst[doff[2].value()] = scale * src[soff[2].value()];
+    else {
+      const size_t ds = dld[0], ss = sld[0];
+      if constexpr(Acc) {
+        for(size_t i = 0; i < n; i++) dst[i * ds] += scale * src[i * ss];
+      }
+      else {
+        for(size_t i = 0; i < n; i++) dst[i * ds] = scale * src[i * ss];
       }
     }
   }
-}
-
-template<typename T>
-void ip4(const SizeVec& loop_dims, T* dst, const SizeVec& loop_dld, T scale, const T* src,
-         const SizeVec& loop_sld) {
-  const size_t ndim = 4;
-  Size         soff[ndim], doff[ndim];
-  size_t       i[ndim];
-
-  for(i[0] = 0, soff[0] = 0, doff[0] = 0; i[0] < loop_dims[0];
-      i[0]++, soff[0] += loop_sld[0], doff[0] += loop_dld[0]) {
-    for(i[1] = 0, soff[1] = soff[0], doff[1] = doff[0]; i[1] < loop_dims[1];
-        i[1]++, soff[1] += loop_sld[1], doff[1] += loop_dld[1]) {
-      for(i[2] = 0, soff[2] = soff[1], doff[2] = doff[1]; i[2] < loop_dims[2];
-          i[2]++, soff[2] += loop_sld[2], doff[2] += loop_dld[2]) {
-        for(i[3] = 0, soff[3] = soff[2], doff[3] = doff[2]; i[3] < loop_dims[3];
-            i[3]++, soff[3] += loop_sld[3], doff[3] += loop_dld[3]) {
-          dst[doff[3].value()] = scale * src[soff[3].value()];
-        }
-      }
+  else {
+    for(size_t i = 0; i < dims[0]; i++) {
+      ip_strided<N - 1, Acc>(dims + 1, dst + i * dld[0], dld + 1, scale, src + i * sld[0],
+                             sld + 1);
     }
   }
 }
 
-template<typename T>
-void ipacc0(const SizeVec& /*loop_dims*/, T* dst, const SizeVec& /*loop_dld*/, T scale,
-            const T* src, const SizeVec& /*loop_sld*/) {
-  dst[0] += scale * src[0];
+template<bool Acc, typename T, size_t... N>
+void ip_strided_dispatch(size_t ndim, const size_t* dims, T* dst, const size_t* dld, T scale,
+                         const T* src, const size_t* sld, std::index_sequence<N...>) {
+  EXPECTS(ndim <= ip_max_rank);
+  ((ndim == N ? ip_strided<N, Acc>(dims, dst, dld, scale, src, sld) : void()), ...);
 }
 
+/// dst = scale * src (or dst += scale * src when @p is_assign is false) over the first @p ndim
+/// loops described by @p loop_dims, @p loop_dld and @p loop_sld
 template<typename T>
-void ipacc1(const SizeVec& loop_dims, T* dst, const SizeVec& loop_dld, T scale, const T* src,
-            const SizeVec& loop_sld) {
-  const size_t ndim = 1;
-  Size         soff[ndim], doff[ndim];
-  size_t       i[ndim];
-
-  for(i[0] = 0, soff[0] = 0, doff[0] = 0; i[0] < loop_dims[0];
-      i[0]++, soff[0] += loop_sld[0], doff[0] += loop_dld[0]) {
-    dst[doff[0].value()] += scale * src[soff[0].value()];
+void ip_strided(size_t ndim, const SizeVec& loop_dims, T* dst, const SizeVec& loop_dld, T scale,
+                const T* src, const SizeVec& loop_sld, bool is_assign) {
+  std::array<size_t, ip_max_rank> dims{}, dld{}, sld{};
+  EXPECTS(ndim <= ip_max_rank);
+  for(size_t i = 0; i < ndim; i++) {
+    dims[i] = loop_dims[i].value();
+    dld[i]  = loop_dld[i].value();
+    sld[i]  = loop_sld[i].value();
+  }
+  if(is_assign) {
+    ip_strided_dispatch<false>(ndim, dims.data(), dst, dld.data(), scale, src, sld.data(),
+                               std::make_index_sequence<ip_max_rank + 1>{});
   }
+  else {
+    ip_strided_dispatch<true>(ndim, dims.data(), dst, dld.data(), scale, src, sld.data(),
+                              std::make_index_sequence<ip_max_rank + 1>{});
+  }
+}
+
+inline size_t idx(int n, const size_t* id, const Size* sz, const PermVector& p) {
+  Size idx = 0;
+  for(int i = 0; i < n - 1; i++) { idx = (idx + id[p[i]]) * sz[p[i + 1]]; }
+  if(n > 0) { idx += id[p[n - 1]]; }
+  return idx.value();
 }
 
+/// index_permute/index_permute_acc for ranks without a hand-written loop nest
 template<typename T>
-void ipacc2(const SizeVec& loop_dims, T* dst, const SizeVec& loop_dld, T scale, const T* src,
-            const SizeVec& loop_sld) {
-  const size_t ndim = 2;
-  Size         soff[ndim], doff[ndim];
-  size_t       i[ndim];
-
-  for(i[0] = 0, soff[0] = 0, doff[0] = 0; i[0] < loop_dims[0];
-      i[0]++, soff[0] += loop_sld[0], doff[0] += loop_dld[0]) {
-    for(i[1] = 0, soff[1] = soff[0], doff[1] = doff[0]; i[1] < loop_dims[1];
-        i[1]++, soff[1] += loop_sld[1], doff[1] += loop_dld[1]) {
-      dst[doff[1].value()] += scale * src[soff[1].value()];
-    }
+void index_permute_strided(T* dbuf, const T* sbuf, const PermVector& perm_to_dest,
+                           const SizeVec& ddims, T scale, bool is_assign) {
+  const size_t ndim = ddims.size();
+  SizeVec      dld(ndim), sld(ndim);
+  Size         dstride = 1, sstride = 1;
+  for(size_t d = ndim; d-- > 0;) {
+    dld[d] = dstride;
+    dstride *= ddims[d];
   }
+  for(size_t k = ndim; k-- > 0;) {
+    sld[perm_to_dest[k]] = sstride;
+    sstride *= ddims[perm_to_dest[k]];
+  }
+  ip_strided(ndim, ddims, dbuf, dld, scale, sbuf, sld, is_assign);
 }
 
+/// dst = scale * src, or dst += scale * src when @p is_assign is false, over @p n elements
 template<typename T>
-void ipacc3(const SizeVec& loop_dims, T* dst, const SizeVec& loop_dld, T scale, const T* src,
-            const SizeVec& loop_sld) {
-  const size_t ndim = 3;
-  Size         soff[ndim], doff[ndim];
-  size_t       i[ndim];
-
-  for(i[0] = 0, soff[0] = 0, doff[0] = 0; i[0] < loop_dims[0];
-      i[0]++, soff[0] += loop_sld[0], doff[0] += loop_dld[0]) {
-    for(i[1] = 0, soff[1] = soff[0], doff[1] = doff[0]; i[1] < loop_dims[1];
-        i[1]++, soff[1] += loop_sld[1], doff[1] += loop_dld[1]) {
-      for(i[2] = 0, soff[2] = soff[1], doff[2] = doff[1]; i[2] < loop_dims[2];
-          i[2]++, soff[2] += loop_sld[2], doff[2] += loop_dld[2]) {
-        dst[doff[2].value()] += scale * src[soff[2].value()];
-      }
-    }
+void flat_axpy(T* dst, T scale, const T* src, size_t n, bool is_assign) {
+  if(is_assign && scale == T{1}) {
+    std::memcpy(dst, src, n * sizeof(T));
+    return;
   }
+  if(is_assign) kernels::flat::scale(dst, scale, src, n);
+  else kernels::flat::axpy(dst, scale, src, n);
 }
 
+/**
+ * @brief Fast path for permutations that keep a trailing run of dims in place. The identity is
+ * a single flat copy/axpy; otherwise the run is fused into one contiguous innermost loop.
+ *
+ * @return false if the permutation does not qualify and nothing was done
+ */
 template<typename T>
-void ipacc4(const SizeVec& loop_dims, T* dst, const SizeVec& loop_dld, T scale, const T* src,
-            const SizeVec& loop_sld) {
-  const size_t ndim = 4;
-  Size         soff[ndim], doff[ndim];
-  size_t       i[ndim];
-
-  for(i[0] = 0, soff[0] = 0, doff[0] = 0; i[0] < loop_dims[0];
-      i[0]++, soff[0] += loop_sld[0], doff[0] += loop_dld[0]) {
-    for(i[1] = 0, soff[1] = soff[0], doff[1] = doff[0]; i[1] < loop_dims[1];
-        i[1]++, soff[1] += loop_sld[1], doff[1] += loop_dld[1]) {
-      for(i[2] = 0, soff[2] = soff[1], doff[2] = doff[1]; i[2] < loop_dims[2];
-          i[2]++, soff[2] += loop_sld[2], doff[2] += loop_dld[2]) {
-        for(i[3] = 0, soff[3] = soff[2], doff[3] = doff[2]; i[3] < loop_dims[3];
-            i[3]++, soff[3] += loop_sld[3], doff[3] += loop_dld[3]) {
-          dst[doff[3].value()] += scale * src[soff[3].value()];
-        }
-      }
-    }
+bool index_permute_contiguous(T* dbuf, const T* sbuf, const PermVector& perm_to_dest,
+                              const SizeVec& ddims, T scale, bool is_assign) {
+  // shorter fused runs are not worth leaving the general kernels for
+  constexpr size_t min_run = 16;
+
+  const size_t ndim   = ddims.size();
+  size_t       nfixed = 0;
+  while(nfixed < ndim && perm_to_dest[ndim - 1 - nfixed] == static_cast<Perm>(ndim - 1 - nfixed)) {
+    nfixed++;
   }
-}
+  if(nfixed == 0) return false;
 
-inline size_t idx(int n, const size_t* id, const Size* sz, const PermVector& p) {
-  Size idx = 0;
-  for(int i = 0; i < n - 1; i++) { idx = (idx + id[p[i]]) * sz[p[i + 1]]; }
-  if(n > 0) { idx += id[p[n - 1]]; }
-  return idx.value();
+  size_t run = 1;
+  for(size_t d = ndim - nfixed; d < ndim; d++) run *= ddims[d].value();
+  if(nfixed == ndim) {
+    flat_axpy(dbuf, scale, sbuf, run, is_assign);
+    return true;
+  }
+  if(run < min_run || ndim - nfixed + 1 > ip_max_rank) return false;
+
+  PermVector perm(perm_to_dest.begin(), perm_to_dest.end() - nfixed);
+  SizeVec    dims(ddims.begin(), ddims.end() - nfixed);
+  perm.push_back(static_cast<Perm>(ndim - nfixed));
+  dims.push_back(run);
+  index_permute_strided(dbuf, sbuf, perm, dims, scale, is_assign);
+  return true;
 }
 
 template<typename T>
@@ -184,9 +175,11 @@ void index_permute_acc(T* dbuf, const T* sbuf, const PermVector& perm_to_dest, c
   const size_t ndim = perm_to_dest.size();
   EXPECTS(ddims.size() == ndim);
 
+  if(index_permute_contiguous(dbuf, sbuf, perm_to_dest, ddims, scale, false)) return;
+
   if(ndim == 0) { dbuf[0] += scale * sbuf[0]; }
   else if(ndim == 1) {
-    for(size_t i = 0; i < ddims[0]; i++) { dbuf[i] = scale * sbuf[i]; }
+    for(size_t i = 0; i < ddims[0]; i++) { dbuf[i] += scale * sbuf[i]; }
   }
   else if(ndim == 2) {
     Size   sz[] = {ddims[0], ddims[1]};
@@ -224,7 +217,7 @@ void index_permute_acc(T* dbuf, const T* sbuf, const PermVector& perm_to_dest, c
       }
     }
   }
-  else { NOT_IMPLEMENTED(); }
+  else { index_permute_strided(dbuf, sbuf, perm_to_dest, ddims, scale, false); }
 }
 
 template<typename T>
@@ -236,6 +229,8 @@ void index_permute(T* dbuf, const T* sbuf, const PermVector& perm_to_dest, const
   const size_t ndim = perm_to_dest.size();
   EXPECTS(ddims.size() == ndim);
 
+  if(index_permute_contiguous(dbuf, sbuf, perm_to_dest, ddims, scale, true)) return;
+
   if(ndim == 0) { dbuf[0] = scale * sbuf[0]; }
   else if(ndim == 1) {
     for(size_t i = 0; i < ddims[0]; i++) { dbuf[i] = scale * sbuf[i]; }
@@ -276,7 +271,7 @@ void index_permute(T* dbuf, const T* sbuf, const PermVector& perm_to_dest, const
       }
     }
   }
-  else { NOT_IMPLEMENTED(); }
+  else { index_permute_strided(dbuf, sbuf, perm_to_dest, ddims, scale, true); }
 }
 
 template<typename T>
@@ -354,22 +349,7 @@ void ip_gen_loop(T* dst, const SizeVec& ddims, const IntLabelVec& dlabels, T sca
     }
   }
 
-  if(is_assign) {
-    if(ndim == 0) { internal::ip0(loop_dims, dst, loop_dld, scale, src, loop_sld); }
-    else if(ndim == 1) { internal::ip1(loop_dims, dst, loop_dld, scale, src, loop_sld); }
-    else if(ndim == 2) { internal::ip2(loop_dims, dst, loop_dld, scale, src, loop_sld); }
-    else if(ndim == 3) { internal::ip3(loop_dims, dst, loop_dld, scale, src, loop_sld); }
-    else if(ndim == 4) { internal::ip4(loop_dims, dst, loop_dld, scale, src, loop_sld); }
-    else { NOT_IMPLEMENTED(); }
-  }
-  else {
-    if(ndim == 0) { internal::ipacc0(loop_dims, dst, loop_dld, scale, src, loop_sld); }
-    else if(ndim == 1) { internal::ipacc1(loop_dims, dst, loop_dld, scale, src, loop_sld); }
-    else if(ndim == 2) { internal::ipacc2(loop_dims, dst, loop_dld, scale, src, loop_sld); }
-    else if(ndim == 3) { internal::ipacc3(loop_dims, dst, loop_dld, scale, src, loop_sld); }
-    else if(ndim == 4) { internal::ipacc4(loop_dims, dst, loop_dld, scale, src, loop_sld); }
-    else { NOT_IMPLEMENTED(); }
-  }
+  internal::ip_strided(ndim, loop_dims, dst, loop_dld, scale, src, loop_sld, is_assign);
 }
 
 template<typename T>
@@ -384,20 +364,19 @@ void ip_hptt(T* dst, const SizeVec& ddims, const IntLabelVec& dlabels, T scale,
   const int ndim = ddims.size();
   int       perm[ndim];
   int       size[ndim];
-  T         beta       = is_assign ? 0 : 1;
-  int       numThreads = 1;
-  for(size_t i = 0; i < sdims.size(); i++) { size[i] = sdims[i].value(); }
+  T         beta      = is_assign ? 0 : 1;
+  size_t    nelements = 1;
+  for(size_t i = 0; i < sdims.size(); i++) {
+    size[i] = sdims[i].value();
+    nelements *= size[i];
+  }
+  const int numThreads = kernel_threads(nelements);
   for(size_t i = 0; i < dlabels.size(); i++) {
     auto it = std::find(slabels.begin(), slabels.end(), dlabels[i]);
     EXPECTS(it != slabels.end());
     perm[i] = it - slabels.begin();
   }
-  // create a plan (shared_ptr)
-  auto plan = hptt::create_plan(perm, ndim, scale, src, size, NULL, beta, dst, NULL, hptt::ESTIMATE,
-                                numThreads, NULL, true);
-
-  // execute the transposition
-  plan->execute();
+  HPTTPlanCache::instance().transpose(perm, ndim, scale, src, size, beta, dst, numThreads);
 }
 
 /**
@@ -474,11 +453,19 @@ void assign(T* dst, const SizeVec& ddims, const IntLabelVec& dlabels, T scale, c
   // assert(sdims.size() == slabels.size());
 
   if(internal::are_permutations(slabels, dlabels)) {
+    auto perm_to_dest = internal::perm_compute(dlabels, slabels);
     if(ndim == 0) {
-      auto perm_to_dest = internal::perm_compute(dlabels, slabels);
       if(is_assign) { internal::index_permute(dst, src, perm_to_dest, ddims, scale); }
       else { internal::index_permute_acc(dst, src, perm_to_dest, ddims, scale); }
     }
+    else if(internal::index_permute_contiguous(dst, src, perm_to_dest, ddims, scale, is_assign)) {
+      // identity or contiguous trailing dims
+    }
+    else if(ndim <= internal::ip_max_rank &&
+            std::accumulate(ddims.begin(), ddims.end(), Size{1}, std::multiplies<Size>()) <
+              internal::ip_hptt_min_elements) {
+      internal::ip_gen_loop(dst, ddims, dlabels, scale, src, sdims, slabels, is_assign);
+    }
     else internal::ip_hptt(dst, ddims, dlabels, scale, src, sdims, slabels, is_assign);
   }
   else { internal::ip_gen_loop(dst, ddims, dlabels, scale, src, sdims, slabels, is_assign); }
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "tamm/proc_group.hpp"
+#include "tamm/types.hpp"
+#include "tamm/utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace tamm {
+
+namespace detail {
+// TAMM_KERNEL_AUTOTUNE = 0(default, disabled)
+// Time the block product strategies of kernels::block_multiply for every new block shape on
+// rank 0 and use the fastest one on all ranks from then on.
+static const bool tamm_kernel_autotune = [] {
+  bool autotune = false;
+  if(const char* tammAutotune = std::getenv("TAMM_KERNEL_AUTOTUNE")) {
+    autotune = std::atoi(tammAutotune) > 0;
+  }
+  return autotune;
+}();
+
+// TAMM_KERNEL_TUNE_FILE = ""(default, not persisted)
+// File the autotuner loads its decisions from at startup; rank 0 saves them in tamm::finalize.
+static const std::string tamm_kernel_tune_file = [] {
+  std::string tune_file;
+  if(const char* tammTuneFile = std::getenv("TAMM_KERNEL_TUNE_FILE")) { tune_file = tammTuneFile; }
+  return tune_file;
+}();
+} // namespace detail
+
+namespace kernels {
+
+/// Block product strategies selectable by the autotuner
+enum class MultVariant {
+  ttgt   = 0, //< transpose operands, GEMM, transpose the result
+  direct = 1  //< loop kernel over the original layouts, no transposes
+};
+
+/**
+ * @brief Picks the fastest block product strategy per block shape.
+ *
+ * A shape is keyed by the element type, the label pattern of A, B and C and their dims. The
+ * first calls for a new key run every variant a few times, timed by the caller through
+ * record(); afterwards the variant with the lowest time is used. Only a tuning rank samples:
+ * the others run the TTGT path until a decision reaches them through sync(), so all ranks of
+ * a process group use the same kernel for a shape. Decisions can be persisted to a file
+ * (TAMM_KERNEL_TUNE_FILE), so later runs on the same machine skip the tuning. All members are
+ * safe to call from several threads.
+ */
+class MultKernelTuner {
+public:
+  using Key = std::string;
+
+  static constexpr int nvariants = 2;
+  static constexpr int nsamples  = 3;
+
+  static MultKernelTuner& instance() {
+    static MultKernelTuner tuner;
+    return tuner;
+  }
+
+  MultKernelTuner(const MultKernelTuner&)            = delete;
+  MultKernelTuner& operator=(const MultKernelTuner&) = delete;
+
+  /**
+   * @brief Key of a block product. Labels are renumbered in order of first appearance so that
+   * products with the same pattern share a key.
+   */
+  template<typename T>
+  static Key make_key(const IntLabelVec& alabels, const SizeVec& adims, const IntLabelVec& blabels,
+                      const SizeVec& bdims, const IntLabelVec& clabels) {
+    std::map<IntLabel, int> renum;
+    std::ostringstream      os;
+    os << (internal::is_complex_v<T> ? 'c' : 'r') << sizeof(T);
+    auto append = [&](const IntLabelVec& labels, const SizeVec* dims) {
+      os << '|';
+      for(size_t i = 0; i < labels.size(); i++) {
+        auto it = renum.emplace(labels[i], static_cast<int>(renum.size())).first;
+        os << (i ? "," : "") << it->second;
+        if(dims != nullptr) os << ':' << (*dims)[i].value();
+      }
+    };
+    append(alabels, &adims);
+    append(blabels, &bdims);
+    append(clabels, nullptr);
+    return os.str();
+  }
+
+  /// Whether this rank samples the variants of shapes without a decision (the default)
+  void set_tuning(bool tuning) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tuning_ = tuning;
+  }
+
+  /**
+   * @brief Variant to run for @p key: the winner once tuned, otherwise the least sampled one on
+   * a tuning rank and TTGT on the others
+   */
+  MultVariant select(const Key& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto&                       entry = entries_[key];
+    if(entry.winner >= 0) return static_cast<MultVariant>(entry.winner);
+    if(!tuning_) return MultVariant::ttgt;
+    return static_cast<MultVariant>(
+      std::min_element(entry.nsampled, entry.nsampled + nvariants) - entry.nsampled);
+  }
+
+  /// Record that running @p variant for @p key took @p seconds. Ignored on non-tuning ranks.
+  void record(const Key& key, MultVariant variant, double seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(!tuning_) return;
+    auto& entry = entries_[key];
+    if(entry.winner >= 0) return;
+    const int v   = static_cast<int>(variant);
+    entry.best[v] = std::min(entry.best[v], seconds);
+    entry.nsampled[v]++;
+    if(*std::min_element(entry.nsampled, entry.nsampled + nvariants) >= nsamples) {
+      entry.winner = static_cast<int>(std::min_element(entry.best, entry.best + nvariants) -
+                                      entry.best);
+    }
+  }
+
+  bool tuned(const Key& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto                        it = entries_.find(key);
+    return it != entries_.end() && it->second.winner >= 0;
+  }
+
+  /// Number of block shapes with a decision
+  size_t num_tuned() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::count_if(entries_.begin(), entries_.end(),
+                         [](const auto& kv) { return kv.second.winner >= 0; });
+  }
+
+  /// Add the decisions stored in @p path (one "key variant" pair per line)
+  void load(const std::string& path) {
+    std::ifstream               is(path);
+    std::lock_guard<std::mutex> lock(mutex_);
+    read(is);
+  }
+
+  /// Write all decisions to @p path. The file is replaced atomically, so a reader never sees
+  /// a partial file.
+  void save(const std::string& path) const {
+    const std::string tmp = path + ".tmp" + std::to_string(std::random_device{}());
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::ofstream               os(tmp);
+      if(!os) return;
+      write(os);
+    }
+    std::rename(tmp.c_str(), path.c_str());
+  }
+
+  /// Broadcast the decisions of rank 0 of @p pg to its other ranks, which adopt them. Collective.
+  void sync(ProcGroup pg) {
+    const bool  root = pg.rank() == 0;
+    std::string table;
+    if(root) {
+      std::ostringstream          os;
+      std::lock_guard<std::mutex> lock(mutex_);
+      write(os);
+      table = os.str();
+    }
+    int len = static_cast<int>(table.size());
+    pg.broadcast(&len, 0);
+    if(len == 0) return;
+    table.resize(len);
+    pg.broadcast(table.data(), len, 0);
+    if(root) return;
+
+    std::istringstream          is(table);
+    std::lock_guard<std::mutex> lock(mutex_);
+    read(is);
+  }
+
+private:
+  void read(std::istream& is) {
+    Key key;
+    int winner;
+    while(is >> key >> winner) {
+      if(winner >= 0 && winner < nvariants) entries_[key].winner = winner;
+    }
+  }
+
+  void write(std::ostream& os) const {
+    for(const auto& [key, entry]: entries_) {
+      if(entry.winner >= 0) os << key << ' ' << entry.winner << '\n';
+    }
+  }
+
+  MultKernelTuner() {
+    if(!detail::tamm_kernel_tune_file.empty()) load(detail::tamm_kernel_tune_file);
+  }
+
+  struct Entry {
+    int    nsampled[nvariants]{};
+    double best[nvariants]{std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    int    winner = -1;
+  };
+
+  mutable std::mutex   mutex_;
+  std::map<Key, Entry> entries_;
+  bool                 tuning_ = true;
+}; // class MultKernelTuner
+
+} // namespace kernels
+
+} // namespace tamm
@@ -10,6 +10,9 @@ void tamm::kernels::cpu::gemm(int m, int n, int k, const T alpha, const T2* A, i
 }
 
 // Explicit template instantiations
+template void tamm::kernels::cpu::gemm(int m, int n, int k, const float alpha, const float* A,
+                                       int lda, const float* B, int ldb, const float beta, float* C,
+                                       int ldc);
 template void tamm::kernels::cpu::gemm(int m, int n, int k, const double alpha, const double* A,
                                        int lda, const double* B, int ldb, const double beta,
                                        double* C, int ldc);
@@ -18,3 +21,8 @@ template void tamm::kernels::cpu::gemm(int m, int n, int k, const std::complex<d
                                        const std::complex<double>* B, int ldb,
                                        const std::complex<double> beta, std::complex<double>* C,
                                        int ldc);
+template void tamm::kernels::cpu::gemm(int m, int n, int k, const std::complex<float> alpha,
+                                       const std::complex<float>* A, int lda,
+                                       const std::complex<float>* B, int ldb,
+                                       const std::complex<float> beta, std::complex<float>* C,
+                                       int ldc);
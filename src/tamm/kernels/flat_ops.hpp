@@ -0,0 +1,263 @@
+#pragma once
+
+#include "tamm/types.hpp"
+#include "tamm/utils.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// The kernels below are written once as plain simd loops and compiled for several instruction
+// sets; the widest one supported by the running CPU is picked at runtime.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TAMM_FLAT_X86 1
+#define TAMM_FLAT_INLINE __attribute__((always_inline))
+#else
+#define TAMM_FLAT_INLINE
+#endif
+
+namespace tamm::kernels::flat {
+
+/// Instruction sets the flat kernels are compiled for
+enum class SimdISA { generic, avx2, avx512 };
+
+inline const char* to_string(SimdISA isa) {
+  switch(isa) {
+    case SimdISA::generic: return "generic";
+    case SimdISA::avx2: return "avx2";
+    case SimdISA::avx512: return "avx512";
+  }
+  return "unknown";
+}
+
+/// Widest instruction set supported by the CPU
+inline SimdISA simd_isa() {
+  static const SimdISA isa = [] {
+#if defined(TAMM_FLAT_X86)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+      return SimdISA::avx512;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdISA::avx2;
+#endif
+    return SimdISA::generic;
+  }();
+  return isa;
+}
+
+namespace detail {
+
+// Each wrapper compiles the (force-inlined) kernel body for its instruction set
+template<typename Kernel>
+void run_generic(const Kernel& kernel, size_t lo, size_t hi) {
+  kernel(lo, hi);
+}
+
+#if defined(TAMM_FLAT_X86)
+template<typename Kernel>
+__attribute__((target("avx2,fma"))) void run_avx2(const Kernel& kernel, size_t lo, size_t hi) {
+  kernel(lo, hi);
+}
+
+template<typename Kernel>
+__attribute__((target("avx512f,avx512dq"))) void run_avx512(const Kernel& kernel, size_t lo,
+                                                             size_t hi) {
+  kernel(lo, hi);
+}
+#endif
+
+/// Runs @p kernel over [0, n) with the code for @p isa, split over the kernel threads
+template<typename Kernel>
+void run(SimdISA isa, size_t n, const Kernel& kernel) {
+  auto chunk = [&](size_t lo, size_t hi) {
+    switch(isa) {
+#if defined(TAMM_FLAT_X86)
+      case SimdISA::avx512: run_avx512(kernel, lo, hi); break;
+      case SimdISA::avx2: run_avx2(kernel, lo, hi); break;
+#endif
+      default: run_generic(kernel, lo, hi); break;
+    }
+  };
+
+  const int nthreads = internal::kernel_threads(n);
+  if(nthreads <= 1) {
+    chunk(0, n);
+    return;
+  }
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+  for(int t = 0; t < nthreads; t++) { chunk(n * t / nthreads, n * (t + 1) / nthreads); }
+}
+
+template<typename T>
+struct real_of {
+  using type = T;
+};
+template<typename T>
+struct real_of<std::complex<T>> {
+  using type = T;
+};
+
+// Complex products spelled out on the real and imaginary parts, which vectorizes unlike
+// std::complex's operator* (that has to handle inf/nan)
+template<typename R>
+TAMM_FLAT_INLINE inline void cmul(R ar, R ai, R br, R bi, R& cr, R& ci) {
+  cr = ar * br - ai * bi;
+  ci = ar * bi + ai * br;
+}
+
+} // namespace detail
+
+/// x[i] = a
+template<typename T>
+void set(T* x, T a, size_t n, SimdISA isa = simd_isa()) {
+  detail::run(isa, n, [=](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+    for(size_t i = lo; i < hi; i++) x[i] = a;
+  });
+}
+
+/// y[i] = x[i]; a memcpy split over the kernel threads
+template<typename T>
+void copy(T* y, const T* x, size_t n) {
+  detail::run(SimdISA::generic, n, [=](size_t lo, size_t hi) {
+    std::memcpy(y + lo, x + lo, (hi - lo) * sizeof(T));
+  });
+}
+
+/// y[i] = a * x[i] (in place when y == x)
+template<typename T>
+void scale(T* y, T a, const T* x, size_t n, SimdISA isa = simd_isa()) {
+  if constexpr(internal::is_complex_v<T>) {
+    using R = typename detail::real_of<T>::type;
+
+    R*       yr = reinterpret_cast<R*>(y);
+    const R* xr = reinterpret_cast<const R*>(x);
+    const R  ar = a.real(), ai = a.imag();
+    detail::run(isa, n, [=](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+      for(size_t i = lo; i < hi; i++) {
+        R cr, ci;
+        detail::cmul(ar, ai, xr[2 * i], xr[2 * i + 1], cr, ci);
+        yr[2 * i]     = cr;
+        yr[2 * i + 1] = ci;
+      }
+    });
+  }
+  else {
+    detail::run(isa, n, [=](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+      for(size_t i = lo; i < hi; i++) y[i] = a * x[i];
+    });
+  }
+}
+
+/// y[i] = b * y[i] + a * x[i]; y is not read when b == 0
+template<typename T>
+void axpby(T* y, T b, T a, const T* x, size_t n, SimdISA isa = simd_isa()) {
+  if(b == T{0}) {
+    scale(y, a, x, n, isa);
+    return;
+  }
+  if constexpr(internal::is_complex_v<T>) {
+    using R = typename detail::real_of<T>::type;
+
+    R*       yr = reinterpret_cast<R*>(y);
+    const R* xr = reinterpret_cast<const R*>(x);
+    const R  ar = a.real(), ai = a.imag(), br = b.real(), bi = b.imag();
+    detail::run(isa, n, [=](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+      for(size_t i = lo; i < hi; i++) {
+        R ur, ui, vr, vi;
+        detail::cmul(br, bi, yr[2 * i], yr[2 * i + 1], ur, ui);
+        detail::cmul(ar, ai, xr[2 * i], xr[2 * i + 1], vr, vi);
+        yr[2 * i]     = ur + vr;
+        yr[2 * i + 1] = ui + vi;
+      }
+    });
+  }
+  else if(b == T{1}) {
+    detail::run(isa, n, [=](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+      for(size_t i = lo; i < hi; i++) y[i] += a * x[i];
+    });
+  }
+  else {
+    detail::run(isa, n, [=](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+      for(size_t i = lo; i < hi; i++) y[i] = b * y[i] + a * x[i];
+    });
+  }
+}
+
+/// y[i] += a * x[i]
+template<typename T>
+void axpy(T* y, T a, const T* x, size_t n, SimdISA isa = simd_isa()) {
+  axpby(y, T{1}, a, x, n, isa);
+}
+
+/// z[i] = b * z[i] + a * x[i] * y[i] (Hadamard product); z is not read when b == 0
+template<typename T>
+void hadamard(T* z, T b, T a, const T* x, const T* y, size_t n, SimdISA isa = simd_isa()) {
+  if constexpr(internal::is_complex_v<T>) {
+    using R = typename detail::real_of<T>::type;
+
+    R*         zr     = reinterpret_cast<R*>(z);
+    const R*   xr     = reinterpret_cast<const R*>(x);
+    const R*   yr     = reinterpret_cast<const R*>(y);
+    const R    ar     = a.real(), ai = a.imag(), br = b.real(), bi = b.imag();
+    const bool assign = b == T{0};
+    detail::run(isa, n, [=](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+      for(size_t i = lo; i < hi; i++) {
+        R pr, pi, vr, vi, ur = 0, ui = 0;
+        detail::cmul(xr[2 * i], xr[2 * i + 1], yr[2 * i], yr[2 * i + 1], pr, pi);
+        detail::cmul(ar, ai, pr, pi, vr, vi);
+        if(!assign) detail::cmul(br, bi, zr[2 * i], zr[2 * i + 1], ur, ui);
+        zr[2 * i]     = ur + vr;
+        zr[2 * i + 1] = ui + vi;
+      }
+    });
+  }
+  else if(b == T{0}) {
+    detail::run(isa, n, [=](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+      for(size_t i = lo; i < hi; i++) z[i] = a * x[i] * y[i];
+    });
+  }
+  else {
+    detail::run(isa, n, [=](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+      for(size_t i = lo; i < hi; i++) z[i] = b * z[i] + a * x[i] * y[i];
+    });
+  }
+}
+
+/// z[i] = x[i] / y[i]. Complex quotients use the textbook formula, without the rescaling
+/// std::complex applies against overflow.
+template<typename T>
+void divide(T* z, const T* x, const T* y, size_t n, SimdISA isa = simd_isa()) {
+  if constexpr(internal::is_complex_v<T>) {
+    using R = typename detail::real_of<T>::type;
+
+    R*       zr = reinterpret_cast<R*>(z);
+    const R* xr = reinterpret_cast<const R*>(x);
+    const R* yr = reinterpret_cast<const R*>(y);
+    detail::run(isa, n, [=](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+      for(size_t i = lo; i < hi; i++) {
+        const R a = xr[2 * i], b = xr[2 * i + 1], c = yr[2 * i], d = yr[2 * i + 1];
+        const R s = R{1} / (c * c + d * d);
+        zr[2 * i]     = (a * c + b * d) * s;
+        zr[2 * i + 1] = (b * c - a * d) * s;
+      }
+    });
+  }
+  else {
+    detail::run(isa, n, [=](size_t lo, size_t hi) TAMM_FLAT_INLINE {
+#pragma omp simd
+      for(size_t i = lo; i < hi; i++) z[i] = x[i] / y[i];
+    });
+  }
+}
+
+} // namespace tamm::kernels::flat
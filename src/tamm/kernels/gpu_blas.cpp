@@ -58,8 +58,17 @@ void tamm::kernels::gpu::gemm(int n, int m, int k, const T alpha, const T3* B, i
 #endif // USE_PORT_BLAS
 
 #elif defined(USE_CUDA)
-  if constexpr(tamm::internal::is_complex_v<T1> && tamm::internal::is_complex_v<T2> &&
-               tamm::internal::is_complex_v<T3>) {
+  if constexpr(std::is_same_v<T1, float>) {
+    CUBLAS_CHECK(cublasSgemm(handle.second, CUBLAS_OP_N, CUBLAS_OP_N, n, m, k, &alpha, B, ldb, A,
+                             lda, &beta, C, ldc));
+  }
+  else if constexpr(std::is_same_v<T1, std::complex<float>>) {
+    CUBLAS_CHECK(cublasCgemm(handle.second, CUBLAS_OP_N, CUBLAS_OP_N, n, m, k, (cuComplex*) &alpha,
+                             (cuComplex*) B, ldb, (cuComplex*) A, lda, (cuComplex*) &beta,
+                             (cuComplex*) C, ldc));
+  }
+  else if constexpr(tamm::internal::is_complex_v<T1> && tamm::internal::is_complex_v<T2> &&
+                    tamm::internal::is_complex_v<T3>) {
     CUBLAS_CHECK(cublasZgemm(handle.second, CUBLAS_OP_N, CUBLAS_OP_N, n, m, k,
                              (cuDoubleComplex*) &alpha, (cuDoubleComplex*) B, ldb,
                              (cuDoubleComplex*) A, lda, (cuDoubleComplex*) &beta,
@@ -70,8 +79,18 @@ void tamm::kernels::gpu::gemm(int n, int m, int k, const T alpha, const T3* B, i
                              lda, &beta, C, ldc));
   }
 #elif defined(USE_HIP)
-  if constexpr(internal::is_complex_v<T1> && internal::is_complex_v<T2> &&
-               internal::is_complex_v<T3>) {
+  if constexpr(std::is_same_v<T1, float>) {
+    ROCBLAS_CHECK(rocblas_sgemm(handle.second, rocblas_operation_none, rocblas_operation_none, n, m,
+                                k, &alpha, B, ldb, A, lda, &beta, C, ldc));
+  }
+  else if constexpr(std::is_same_v<T1, std::complex<float>>) {
+    ROCBLAS_CHECK(rocblas_cgemm(handle.second, rocblas_operation_none, rocblas_operation_none, n, m,
+                                k, (rocblas_float_complex*) &alpha, (rocblas_float_complex*) B, ldb,
+                                (rocblas_float_complex*) A, lda, (rocblas_float_complex*) &beta,
+                                (rocblas_float_complex*) C, ldc));
+  }
+  else if constexpr(internal::is_complex_v<T1> && internal::is_complex_v<T2> &&
+                    internal::is_complex_v<T3>) {
     ROCBLAS_CHECK(rocblas_zgemm(handle.second, rocblas_operation_none, rocblas_operation_none, n, m,
                                 k, (rocblas_double_complex*) &alpha, (rocblas_double_complex*) B,
                                 ldb, (rocblas_double_complex*) A, lda,
@@ -90,7 +109,15 @@ template void tamm::kernels::gpu::axpy(const int64_t n, const double* src, const
 template void tamm::kernels::gpu::gemm(int n, int m, int k, const double alpha, const double* B,
                                        int ldb, const double* A, int lda, const double beta,
                                        double* C, int ldc, gpuStream_t& handle);
+template void tamm::kernels::gpu::gemm(int n, int m, int k, const float alpha, const float* B,
+                                       int ldb, const float* A, int lda, const float beta, float* C,
+                                       int ldc, gpuStream_t& handle);
 #if !defined(USE_PORT_BLAS)
+template void tamm::kernels::gpu::gemm(int n, int m, int k, const std::complex<float> alpha,
+                                       const std::complex<float>* B, int ldb,
+                                       const std::complex<float>* A, int lda,
+                                       const std::complex<float> beta, std::complex<float>* C,
+                                       int ldc, gpuStream_t& handle);
 template void tamm::kernels::gpu::gemm(int n, int m, int k, const std::complex<double> alpha,
                                        const std::complex<double>* B, int ldb,
                                        const std::complex<double>* A, int lda,
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "tamm/errors.hpp"
+#include "tamm/lru_cache.hpp"
+#include "tamm/utils.hpp"
+
+#include "hptt/hptt.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace tamm {
+
+namespace detail {
+// TAMM_HPTT_PLAN_CACHE_SIZE = 256(default)
+// Maximum number of HPTT transpose plans kept for reuse. 0 creates a new plan for every call.
+static const uint32_t tamm_hptt_plan_cache_size = [] {
+  int cache_size = 256;
+  if(const char* tammCacheSize = std::getenv("TAMM_HPTT_PLAN_CACHE_SIZE")) {
+    cache_size = std::atoi(tammCacheSize);
+  }
+  return static_cast<uint32_t>(std::max(cache_size, 0));
+}();
+} // namespace detail
+
+namespace internal {
+
+/**
+ * @brief Per-thread cache of HPTT transpose plans.
+ *
+ * Plans are keyed by element type, permutation, dims, thread count and whether alpha/beta are
+ * 0, 1 or general. A hit rebinds the buffers and scaling factors of the cached plan, so the plan
+ * creation cost is paid once per shape. The least recently used plan is dropped once
+ * TAMM_HPTT_PLAN_CACHE_SIZE plans are cached. Since a hit mutates the plan before running it,
+ * every thread has its own cache and transposes on different threads never share a plan.
+ */
+class HPTTPlanCache {
+public:
+  static HPTTPlanCache& instance() {
+    thread_local HPTTPlanCache plan_cache;
+    return plan_cache;
+  }
+
+  HPTTPlanCache(const HPTTPlanCache&)            = delete;
+  HPTTPlanCache& operator=(const HPTTPlanCache&) = delete;
+
+  /// B(perm(i)) = alpha * A(i) + beta * B(perm(i)), row-major, through a cached plan
+  template<typename T>
+  void transpose(const int* perm, int ndim, T alpha, const T* A, const int* size, T beta, T* B,
+                 int num_threads) {
+    auto kind = [](T v) { return v == T{0} ? 0 : (v == T{1} ? 1 : 2); };
+
+    std::vector<int> key{static_cast<int>(2 * sizeof(T) + internal::is_complex_v<T>), kind(alpha),
+                         kind(beta), num_threads, ndim};
+    key.insert(key.end(), perm, perm + ndim);
+    key.insert(key.end(), size, size + ndim);
+
+    auto [hit, entry] = plans_.log_access(key);
+    std::shared_ptr<::hptt::Transpose<T>> plan;
+    if(hit && entry) {
+      plan = std::static_pointer_cast<::hptt::Transpose<T>>(entry);
+      plan->setAlpha(alpha);
+      plan->setBeta(beta);
+      plan->setInputPtr(A);
+      plan->setOutputPtr(B);
+      num_hits_++;
+    }
+    else {
+      plan  = ::hptt::create_plan(perm, ndim, alpha, A, size, NULL, beta, B, NULL,
+                                  ::hptt::ESTIMATE, num_threads, NULL, true);
+      entry = plan;
+      num_created_++;
+    }
+    plan->execute();
+  }
+
+  /// Number of transposes that reused a cached plan
+  size_t num_hits() const { return num_hits_; }
+
+  /// Number of plans created
+  size_t num_created() const { return num_created_; }
+
+  void clear() {
+    plans_.clear();
+    num_hits_    = 0;
+    num_created_ = 0;
+  }
+
+private:
+  HPTTPlanCache(): plans_{detail::tamm_hptt_plan_cache_size} {}
+
+  LRUCache<int, std::shared_ptr<void>> plans_;
+  size_t                               num_hits_{0};
+  size_t                               num_created_{0};
+}; // class HPTTPlanCache
+
+} // namespace internal
+
+} // namespace tamm
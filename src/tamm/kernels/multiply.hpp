@@ -2,8 +2,10 @@
 
 #include "tamm/errors.hpp"
 #include "tamm/kernels/assign.hpp"
+#include "tamm/kernels/autotune.hpp"
 #include "tamm/types.hpp"
 
+#include <chrono>
 #include <complex>
 #include <cstring> // for std::memset
 #include <numeric>
@@ -55,17 +57,19 @@ void gemm_wrapper(ExecutionHW hw, gpuStream_t& thandle, int AR, int BR, int B, i
 
   for(size_t ari = 0; ari < AR; ari++) {
     for(size_t bri = 0; bri < BR; bri++) {
+      // beta only applies to the first product, later ones accumulate onto it
+      const T gemm_beta = (ari == 0 && bri == 0) ? beta : T{1};
       for(size_t i = 0; i < B; i++) {
 #if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
         if(hw == ExecutionHW::GPU) {
           gpu::gemm(N, M, K, alpha, binter_buf_dev + bri * breduce_ld + i * bbatch_ld, binter_ld,
-                    ainter_buf_dev + ari * areduce_ld + i * abatch_ld, ainter_ld, beta,
+                    ainter_buf_dev + ari * areduce_ld + i * abatch_ld, ainter_ld, gemm_beta,
                     cinter_buf_dev + i * cbatch_ld, cinter_ld, thandle);
           continue;
         }
 #endif
         cpu::gemm(M, N, K, alpha, ainter_buf + ari * areduce_ld + i * abatch_ld, ainter_ld,
-                  binter_buf + bri * breduce_ld + i * bbatch_ld, binter_ld, beta,
+                  binter_buf + bri * breduce_ld + i * bbatch_ld, binter_ld, gemm_beta,
                   cinter_buf + i * cbatch_ld, cinter_ld);
 
       } // for-i
@@ -209,6 +213,72 @@ void transpose_output(ExecutionHW hw, gpuStream_t& thandle, bool gpu_trans, T1*
   assign<T1>(cbuf, cdims, clabels, T1{1}, cinter_buf, cinter_dims, cinter_labels, is_assign);
 }
 
+/// Offsets, within a row-major buffer with @p labels and @p dims, of every multi-index over
+/// @p group_labels (with @p group_dims), the last group label running fastest.
+inline std::vector<size_t> group_offsets(const std::vector<IntLabel>& group_labels,
+                                         const SizeVec& group_dims, const IntLabelVec& labels,
+                                         const SizeVec& dims) {
+  const size_t        ng = group_labels.size();
+  std::vector<size_t> stride(ng);
+  for(size_t g = 0; g < ng; g++) {
+    const size_t pos = std::find(labels.begin(), labels.end(), group_labels[g]) - labels.begin();
+    stride[g]        = 1;
+    for(size_t d = pos + 1; d < dims.size(); d++) stride[g] *= dims[d].value();
+  }
+
+  size_t n = 1;
+  for(const auto& d: group_dims) n *= d.value();
+  std::vector<size_t> offsets(n);
+  std::vector<size_t> idx(ng, 0);
+  for(size_t e = 0; e < n; e++) {
+    size_t off = 0;
+    for(size_t g = 0; g < ng; g++) off += idx[g] * stride[g];
+    offsets[e] = off;
+    for(size_t g = ng; g-- > 0;) {
+      if(++idx[g] < group_dims[g].value()) break;
+      idx[g] = 0;
+    }
+  }
+  return offsets;
+}
+
+/**
+ * @brief Block product computed in place on the original layouts of A, B and C, without the
+ * transposes of the TTGT path. Pays off for small blocks, where the transposes dominate.
+ */
+template<typename T, typename T1>
+void direct_multiply(T alpha, const T1* abuf, const SizeVec& adims, const IntLabelVec& alabels,
+                     const T1* bbuf, const SizeVec& bdims, const IntLabelVec& blabels, T1* cbuf,
+                     const SizeVec& cdims, const IntLabelVec& clabels, bool is_assign,
+                     const std::vector<IntLabel>& batch_labels, const SizeVec& batch_dims,
+                     const std::vector<IntLabel>& aouter_labels, const SizeVec& aouter_dims,
+                     const std::vector<IntLabel>& bouter_labels, const SizeVec& bouter_dims,
+                     const std::vector<IntLabel>& inner_labels, const SizeVec& inner_dims) {
+  const auto ab = group_offsets(batch_labels, batch_dims, alabels, adims);
+  const auto bb = group_offsets(batch_labels, batch_dims, blabels, bdims);
+  const auto cb = group_offsets(batch_labels, batch_dims, clabels, cdims);
+  const auto am = group_offsets(aouter_labels, aouter_dims, alabels, adims);
+  const auto cm = group_offsets(aouter_labels, aouter_dims, clabels, cdims);
+  const auto bn = group_offsets(bouter_labels, bouter_dims, blabels, bdims);
+  const auto cn = group_offsets(bouter_labels, bouter_dims, clabels, cdims);
+  const auto ak = group_offsets(inner_labels, inner_dims, alabels, adims);
+  const auto bk = group_offsets(inner_labels, inner_dims, blabels, bdims);
+
+  const T1 scale = static_cast<T1>(alpha);
+  for(size_t i = 0; i < cb.size(); i++) {
+    for(size_t m = 0; m < cm.size(); m++) {
+      const T1* arow = abuf + ab[i] + am[m];
+      for(size_t n = 0; n < cn.size(); n++) {
+        const T1* bcol = bbuf + bb[i] + bn[n];
+        T1        sum{0};
+        for(size_t k = 0; k < ak.size(); k++) sum += arow[ak[k]] * bcol[bk[k]];
+        T1& cval = cbuf[cb[i] + cm[m] + cn[n]];
+        cval     = is_assign ? scale * sum : cval + scale * sum;
+      }
+    }
+  }
+}
+
 template<typename T, typename T1, typename T2, typename T3>
 void block_multiply(
 #if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
@@ -340,12 +410,26 @@ void block_multiply(
 
   bool gpu_trans = false;
 
+  // On the CPU, C = alpha * A * B for an assign and C = beta * C + alpha * A * B otherwise.
+  // The GEMM writes straight into cbuf when C is already laid out as [batch, aouter, bouter],
+  // with beta (or 0 for an assign) on its first product. Otherwise it overwrites the
+  // intermediate, which is then permuted into cbuf after cbuf is scaled by beta.
+  constexpr bool c_gemm_type = (std::is_same_v<T1, T2> && std::is_same_v<T1, T3>) ||
+                               internal::is_mixed_precision_v<T1, T2, T3>;
+  const bool     c_direct    = c_gemm_type && hw == ExecutionHW::CPU && cinter_labels == clabels;
+  const T gemm_beta = hw == ExecutionHW::CPU ? (c_direct && !is_assign ? beta : T{0}) : beta;
+  auto scale_cbuf = [&]() {
+    if(hw != ExecutionHW::CPU || is_assign || beta == T{1}) return;
+    T1 cbeta;
+    if constexpr(internal::is_complex_v<T> && !internal::is_complex_v<T1>) cbeta = beta.real();
+    else cbeta = static_cast<T1>(beta);
+    for(size_t i = 0; i < static_cast<size_t>(csize.value()); i++) cbuf[i] *= cbeta;
+  };
+  if(!c_direct) scale_cbuf();
+
   T1* cinter_buf{nullptr};
-  allocate_host_buffers(hw, cinter_buf, static_cast<size_t>(csize.value()));
-  if(hw == ExecutionHW::CPU) {
-    // if(csize.value() != 1)
-    std::memset(static_cast<void*>(cinter_buf), 0, static_cast<size_t>(csize.value() * sizeof(T1)));
-  }
+  if(!c_direct) allocate_host_buffers(hw, cinter_buf, static_cast<size_t>(csize.value()));
+  T1* cgemm_buf = c_direct ? cbuf : cinter_buf;
 
   T2* ainter_buf_dev{nullptr};
   T3* binter_buf_dev{nullptr};
@@ -356,6 +440,28 @@ void block_multiply(
 
   // dgemm
   if constexpr(std::is_same_v<T1, T2> && std::is_same_v<T1, T3>) { // R=RxR, C=CxC
+    // With TAMM_KERNEL_AUTOTUNE, the TTGT path below competes with direct_multiply per block
+    // shape; both are timed on the first blocks of a shape and the faster one is kept.
+    std::string tune_key;
+    if(detail::tamm_kernel_autotune && hw == ExecutionHW::CPU && AR == 1 && BR == 1 &&
+       static_cast<Size>(B * M * N) == csize) {
+      auto& tuner = MultKernelTuner::instance();
+      tune_key    = MultKernelTuner::make_key<T1>(alabels, adims, blabels, bdims, clabels);
+      if(tuner.select(tune_key) == MultVariant::direct) {
+        if(c_direct) scale_cbuf();
+        const auto start = std::chrono::steady_clock::now();
+        direct_multiply(alpha, abuf, adims, alabels, bbuf, bdims, blabels, cbuf, cdims, clabels,
+                        is_assign, batch_labels, batch_dims, aouter_labels, aouter_dims,
+                        bouter_labels, bouter_dims, inner_labels, inner_dims);
+        tuner.record(tune_key, MultVariant::direct,
+                     std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                       .count());
+        if(!c_direct) free_host_buffers(hw, cinter_buf, csize.value());
+        return;
+      }
+    }
+    const auto ttgt_start = std::chrono::steady_clock::now();
+
     T2* ainter_buf{nullptr};
     T3* binter_buf{nullptr};
     allocate_host_buffers(hw, ainter_buf, asize.value());
@@ -370,16 +476,145 @@ void block_multiply(
       copy_data_to_gpu(hw, thandle, ainter_buf, asize.value(), ainter_buf_dev, binter_buf,
                        bsize.value(), binter_buf_dev);
 
-    gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha, beta, ainter_buf, ainter_buf_dev,
-                 binter_buf, binter_buf_dev, cinter_buf, cinter_tmp_buf_dev);
+    gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha, gemm_beta, ainter_buf, ainter_buf_dev,
+                 binter_buf, binter_buf_dev, cgemm_buf, cinter_tmp_buf_dev);
+
+    if(!c_direct)
+      transpose_output(hw, thandle, gpu_trans, cinter_buf, cinter_dims, cinter_labels, cbuf, cdims,
+                       clabels, cinter_buf_dev, cinter_tmp_buf_dev, is_assign);
+
+    free_host_buffers(hw, ainter_buf, asize.value());
+    free_host_buffers(hw, binter_buf, bsize.value());
+
+    if(!tune_key.empty()) {
+      MultKernelTuner::instance().record(
+        tune_key, MultVariant::ttgt,
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - ttgt_start).count());
+    }
+  }
+  else if constexpr(internal::is_mixed_precision_v<T1, T2, T3>) { // e.g. D=SxS, D=SxD
+    // A and/or B are stored in a lower precision than C: widen them once and run the GEMM
+    // (and the accumulation over the reduction) in the precision of C.
+    T1* abuf_wide{nullptr};
+    T1* bbuf_wide{nullptr};
+    allocate_host_buffers(ExecutionHW::CPU, abuf_wide, asize.value());
+    allocate_host_buffers(ExecutionHW::CPU, bbuf_wide, bsize.value());
+    std::copy(abuf, abuf + asize.value(), abuf_wide);
+    std::copy(bbuf, bbuf + bsize.value(), bbuf_wide);
+
+    T1* ainter_buf{nullptr};
+    T1* binter_buf{nullptr};
+    allocate_host_buffers(hw, ainter_buf, asize.value());
+    allocate_host_buffers(hw, binter_buf, bsize.value());
+
+    T1* ainter_wide_dev{nullptr};
+    T1* binter_wide_dev{nullptr};
+    allocate_device_buffers(hw, ainter_wide_dev, asize.value());
+    allocate_device_buffers(hw, binter_wide_dev, bsize.value());
+
+    gpu_trans = transpose_inputs(hw, thandle, ainter_buf, ainter_dims, ainter_labels, abuf_wide,
+                                 asize.value(), adims, alabels, binter_buf, binter_dims,
+                                 binter_labels, bbuf_wide, bsize.value(), bdims, blabels,
+                                 ainter_wide_dev, binter_wide_dev);
+
+    if(!gpu_trans)
+      copy_data_to_gpu(hw, thandle, ainter_buf, asize.value(), ainter_wide_dev, binter_buf,
+                       bsize.value(), binter_wide_dev);
+
+    gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha, gemm_beta, ainter_buf, ainter_wide_dev,
+                 binter_buf, binter_wide_dev, cgemm_buf, cinter_tmp_buf_dev);
 
-    transpose_output(hw, thandle, gpu_trans, cinter_buf, cinter_dims, cinter_labels, cbuf, cdims,
-                     clabels, cinter_buf_dev, cinter_tmp_buf_dev, is_assign);
+    if(!c_direct)
+      transpose_output(hw, thandle, gpu_trans, cinter_buf, cinter_dims, cinter_labels, cbuf, cdims,
+                       clabels, cinter_buf_dev, cinter_tmp_buf_dev, is_assign);
 
+    free_device_buffers(hw, ainter_wide_dev, asize.value());
+    free_device_buffers(hw, binter_wide_dev, bsize.value());
     free_host_buffers(hw, ainter_buf, asize.value());
     free_host_buffers(hw, binter_buf, bsize.value());
+    free_host_buffers(ExecutionHW::CPU, abuf_wide, asize.value());
+    free_host_buffers(ExecutionHW::CPU, bbuf_wide, bsize.value());
   }
   else {
+    // C=CxR, C=RxC on the CPU: instead of promoting the real operand to complex, view the
+    // complex operand as a real matrix of interleaved (re, im) pairs and run one real GEMM with
+    // the real operand on the left. C comes out interleaved as [batch, router, zouter].
+    if constexpr(internal::is_complex_v<T1> && !std::is_same_v<T2, T3> &&
+                 (std::is_same_v<T1, T2> || std::is_same_v<T1, T3>)) {
+      constexpr bool a_is_real = std::is_same_v<T1, T3>;
+      using TR                 = std::conditional_t<a_is_real, T2, T3>;
+      if constexpr(std::is_same_v<TR, typename T1::value_type>) {
+        if(hw == ExecutionHW::CPU && AR == 1 && BR == 1) {
+          const TR* rbuf;
+          const T1* zbuf;
+          if constexpr(a_is_real) {
+            rbuf = abuf;
+            zbuf = bbuf;
+          }
+          else {
+            rbuf = bbuf;
+            zbuf = abuf;
+          }
+          const SizeVec&     rdims         = a_is_real ? adims : bdims;
+          const SizeVec&     zdims         = a_is_real ? bdims : adims;
+          const IntLabelVec& rlabels       = a_is_real ? alabels : blabels;
+          const IntLabelVec& zlabels       = a_is_real ? blabels : alabels;
+          const auto&        router_labels = a_is_real ? aouter_labels : bouter_labels;
+          const auto&        zouter_labels = a_is_real ? bouter_labels : aouter_labels;
+          const auto&        router_dims   = a_is_real ? aouter_dims : bouter_dims;
+          const auto&        zouter_dims   = a_is_real ? bouter_dims : aouter_dims;
+          const int          RM            = a_is_real ? M : N;
+          const int          ZN            = a_is_real ? N : M;
+
+          IntLabelVec rinter_labels{batch_labels};
+          rinter_labels.insert(rinter_labels.end(), router_labels.begin(), router_labels.end());
+          rinter_labels.insert(rinter_labels.end(), inner_labels.begin(), inner_labels.end());
+          SizeVec rinter_dims{batch_dims};
+          rinter_dims.insert(rinter_dims.end(), router_dims.begin(), router_dims.end());
+          rinter_dims.insert(rinter_dims.end(), inner_dims.begin(), inner_dims.end());
+
+          IntLabelVec zinter_labels{batch_labels};
+          zinter_labels.insert(zinter_labels.end(), inner_labels.begin(), inner_labels.end());
+          zinter_labels.insert(zinter_labels.end(), zouter_labels.begin(), zouter_labels.end());
+          SizeVec zinter_dims{batch_dims};
+          zinter_dims.insert(zinter_dims.end(), inner_dims.begin(), inner_dims.end());
+          zinter_dims.insert(zinter_dims.end(), zouter_dims.begin(), zouter_dims.end());
+
+          IntLabelVec rzinter_labels{batch_labels};
+          rzinter_labels.insert(rzinter_labels.end(), router_labels.begin(), router_labels.end());
+          rzinter_labels.insert(rzinter_labels.end(), zouter_labels.begin(), zouter_labels.end());
+          SizeVec rzinter_dims{batch_dims};
+          rzinter_dims.insert(rzinter_dims.end(), router_dims.begin(), router_dims.end());
+          rzinter_dims.insert(rzinter_dims.end(), zouter_dims.begin(), zouter_dims.end());
+
+          const size_t rsize = a_is_real ? asize.value() : bsize.value();
+          const size_t zsize = a_is_real ? bsize.value() : asize.value();
+          TR*          rinter_buf{nullptr};
+          T1*          zinter_buf{nullptr};
+          allocate_host_buffers(hw, rinter_buf, rsize);
+          allocate_host_buffers(hw, zinter_buf, zsize);
+          assign<TR>(rinter_buf, rinter_dims, rinter_labels, TR{1}, rbuf, rdims, rlabels, true);
+          assign<T1>(zinter_buf, zinter_dims, zinter_labels, T1{1}, zbuf, zdims, zlabels, true);
+
+          const TR* zinter_re = reinterpret_cast<const TR*>(zinter_buf);
+          TR*       cinter_re = reinterpret_cast<TR*>(cinter_buf);
+          for(int i = 0; i < B; i++) {
+            cpu::gemm(RM, 2 * ZN, K, TR{1}, rinter_buf + i * RM * K, K,
+                      zinter_re + i * 2 * K * ZN, 2 * ZN, TR{0}, cinter_re + i * 2 * RM * ZN,
+                      2 * ZN);
+          }
+          // alpha may be complex, so it is applied when C is permuted into place
+          assign<T1>(cbuf, cdims, clabels, static_cast<T1>(alpha), cinter_buf, rzinter_dims,
+                     rzinter_labels, is_assign);
+
+          free_host_buffers(hw, rinter_buf, rsize);
+          free_host_buffers(hw, zinter_buf, zsize);
+          free_host_buffers(hw, cinter_buf, csize.value());
+          return;
+        }
+      }
+    }
+
     T2* abufp = const_cast<T2*>(abuf);
     T3* bbufp = const_cast<T3*>(bbuf);
     // TODO: actually check if one of T2, T3 is real, T1 is complex
@@ -410,7 +645,7 @@ void block_multiply(
                            bsize.value(), bbuf_complex_dev);
         }
 
-        gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha, beta, ainter_buf, ainter_buf_dev,
+        gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha, gemm_beta, ainter_buf, ainter_buf_dev,
                      bbuf_complex, bbuf_complex_dev, cinter_buf, cinter_tmp_buf_dev);
         transpose_output(hw, thandle, gpu_trans, cinter_buf, cinter_dims, cinter_labels, cbuf,
                          cdims, clabels, cinter_buf_dev, cinter_tmp_buf_dev, is_assign);
@@ -439,7 +674,7 @@ void block_multiply(
                            bsize.value(), bbuf_real_dev);
         }
 
-        gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha, beta, ainter_buf, ainter_buf_dev,
+        gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha, gemm_beta, ainter_buf, ainter_buf_dev,
                      bbuf_real, bbuf_real_dev, cinter_buf, cinter_tmp_buf_dev);
         transpose_output(hw, thandle, gpu_trans, cinter_buf, cinter_dims, cinter_labels, cbuf,
                          cdims, clabels, cinter_buf_dev, cinter_tmp_buf_dev, is_assign);
@@ -477,8 +712,8 @@ void block_multiply(
                            bsize.value(), binter_buf_dev);
         }
 
-        gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha, beta, abuf_complex, abuf_complex_dev,
-                     binter_buf, binter_buf_dev, cinter_buf, cinter_tmp_buf_dev);
+        gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha, gemm_beta, abuf_complex,
+                     abuf_complex_dev, binter_buf, binter_buf_dev, cinter_buf, cinter_tmp_buf_dev);
 
         transpose_output(hw, thandle, gpu_trans, cinter_buf, cinter_dims, cinter_labels, cbuf,
                          cdims, clabels, cinter_buf_dev, cinter_tmp_buf_dev, is_assign);
@@ -507,7 +742,7 @@ void block_multiply(
                            bsize.value(), binter_buf_dev);
         }
 
-        gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha, beta, abuf_real, abuf_real_dev,
+        gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha, gemm_beta, abuf_real, abuf_real_dev,
                      binter_buf, binter_buf_dev, cinter_buf, cinter_tmp_buf_dev);
         transpose_output(hw, thandle, gpu_trans, cinter_buf, cinter_dims, cinter_labels, cbuf,
                          cdims, clabels, cinter_buf_dev, cinter_tmp_buf_dev, is_assign);
@@ -527,9 +762,6 @@ void block_multiply(
       allocate_host_buffers(hw, ainter_buf, asize.value());
       allocate_host_buffers(hw, binter_buf, bsize.value());
       allocate_host_buffers(hw, cinter_buf_real, csize.value());
-#if !defined(USE_CUDA) && !defined(USE_HIP) && !defined(USE_DPCPP)
-      std::memset(static_cast<void*>(cinter_buf_real), 0, csize.value() * sizeof(T2));
-#endif
 
       T2* cbuf_tmp_real_dev{nullptr};
       allocate_device_buffers(hw, cbuf_tmp_real_dev, csize.value());
@@ -548,7 +780,7 @@ void block_multiply(
                          bsize.value(), binter_buf_dev);
       }
 
-      gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha.real(), beta.real(), ainter_buf,
+      gemm_wrapper(hw, thandle, AR, BR, B, M, N, K, alpha.real(), gemm_beta.real(), ainter_buf,
                    ainter_buf_dev, binter_buf, binter_buf_dev, cinter_buf_real, cbuf_tmp_real_dev);
 
       if(hw == ExecutionHW::GPU) {
@@ -577,13 +809,110 @@ void block_multiply(
   th_b = binter_buf_dev;
 #endif
 
-  if(is_assign && hw != ExecutionHW::GPU) // not using bufacc code path
-    assign<T1>(cbuf, cdims, clabels, T{1}, cinter_buf, cinter_dims, cinter_labels, is_assign);
-
-  free_host_buffers(hw, cinter_buf, csize.value());
+  if(!c_direct) free_host_buffers(hw, cinter_buf, csize.value());
 
 } // block_multiply()
 
+/**
+ * @brief Aggregates consecutive reduction tiles of a contraction into K-panels
+ * so that a single large-K GEMM replaces one small-K GEMM per tile (CPU only).
+ *
+ * The A panel is row-major M x kcap, the B panel is row-major kcap x N. Tiles
+ * are appended along K until the panels are full, then flushed into the
+ * row-major M x N result laid out as [aouter, bouter]. kcap is bounded by the
+ * scratch budget, which covers both panels and the M x kcap scratch A tiles are permuted in,
+ * but always fits at least one tile.
+ *
+ * @tparam T element type of A, B and C
+ */
+template<typename T>
+class KPanelGemm {
+public:
+  KPanelGemm(T alpha, int M, int N, size_t budget_bytes, T* cinter_buf):
+    alpha_{alpha}, M_{M}, N_{N}, cinter_buf_{cinter_buf} {
+    kcap_ = std::max<size_t>(1, budget_bytes / ((2 * M_ + N_) * sizeof(T)));
+  }
+
+  KPanelGemm(const KPanelGemm&)            = delete;
+  KPanelGemm& operator=(const KPanelGemm&) = delete;
+
+  ~KPanelGemm() { release(); }
+
+  /// Appends one pair of reduction tiles. ainter is [aouter, inner], binter is [inner, bouter].
+  void pack(const T* abuf, const SizeVec& adims, const IntLabelVec& alabels,
+            const SizeVec& ainter_dims, const IntLabelVec& ainter_labels, const T* bbuf,
+            const SizeVec& bdims, const IntLabelVec& blabels, const SizeVec& binter_dims,
+            const IntLabelVec& binter_labels, int K) {
+    if(kused_ + K > kcap_) flush();
+    if(static_cast<size_t>(K) > kcap_) {
+      release();
+      kcap_ = K;
+    }
+    if(apanel_ == nullptr) {
+      allocate_host_buffers(ExecutionHW::CPU, apanel_, M_ * kcap_);
+      allocate_host_buffers(ExecutionHW::CPU, bpanel_, kcap_ * N_);
+      allocate_host_buffers(ExecutionHW::CPU, atile_, M_ * kcap_);
+    }
+
+    // B tiles are contiguous slices of the row-major K x N panel
+    assign<T>(bpanel_ + kused_ * N_, binter_dims, binter_labels, T{1}, bbuf, bdims, blabels, true);
+
+    // A tiles occupy a column range of the M x K panel; the tile scratch is sized for the
+    // widest tile that fits the panel and reused across tiles
+    assign<T>(atile_, ainter_dims, ainter_labels, T{1}, abuf, adims, alabels, true);
+    for(int m = 0; m < M_; m++) {
+      std::copy(atile_ + m * K, atile_ + (m + 1) * K, apanel_ + m * kcap_ + kused_);
+    }
+
+    kused_ += K;
+    ntiles_++;
+  }
+
+  /// Multiplies the packed panels into the result. The first flush overwrites it.
+  void flush() {
+    if(kused_ == 0) return;
+    const T beta = touched_ ? T{1} : T{0};
+    cpu::gemm(M_, N_, static_cast<int>(kused_), alpha_, apanel_, static_cast<int>(kcap_), bpanel_,
+              N_, beta, cinter_buf_, N_);
+    touched_ = true;
+    kused_   = 0;
+    nflushes_++;
+  }
+
+  /// True if the result buffer holds data, i.e. at least one flush happened.
+  bool touched() const { return touched_; }
+
+  size_t ntiles() const { return ntiles_; }
+
+  /// Number of GEMMs issued so far
+  size_t nflushes() const { return nflushes_; }
+
+private:
+  void release() {
+    if(apanel_ != nullptr) {
+      free_host_buffers(ExecutionHW::CPU, apanel_, M_ * kcap_);
+      free_host_buffers(ExecutionHW::CPU, bpanel_, kcap_ * N_);
+      free_host_buffers(ExecutionHW::CPU, atile_, M_ * kcap_);
+      apanel_ = nullptr;
+      bpanel_ = nullptr;
+      atile_  = nullptr;
+    }
+  }
+
+  T      alpha_;
+  int    M_;
+  int    N_;
+  T*     cinter_buf_;
+  T*     apanel_{nullptr};
+  T*     bpanel_{nullptr};
+  T*     atile_{nullptr};
+  size_t kcap_{0};
+  size_t kused_{0};
+  size_t ntiles_{0};
+  size_t nflushes_{0};
+  bool   touched_{false};
+}; // class KPanelGemm
+
 } // namespace kernels
 
 } // namespace tamm
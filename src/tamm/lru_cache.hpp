@@ -84,7 +84,7 @@ private:
     }
   };
   uint32_t                                max_size_;
-  uint32_t                                cycle_;
+  uint32_t                                cycle_{0};
   std::map<Key, uint32_t, KeyComp<KeyEl>> cache_;
   std::map<uint32_t, Key>                 cycle_to_key_;
   std::map<Key, Value>                    cached_value_;
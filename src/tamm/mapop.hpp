@@ -4,6 +4,7 @@
 #include <chrono>
 #include <iostream>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 #include "tamm/boundvec.hpp"
@@ -20,6 +21,12 @@ namespace tamm {
 /**
  * @ingroup operations
  * @brief Map operation. Invoke a function on each block of a tensor to set it.
+ *
+ * When the LHS tensor is distributed over the executing process group, every rank only visits
+ * the LHS blocks it owns and writes them directly in its local buffer, without a put. A functor
+ * taking a `span<T>` for the LHS block updates it in place (it sees the current block contents);
+ * one taking a `std::vector<T>&` fills a zero-initialized buffer that is copied into place. RHS
+ * blocks are fetched with get.
  * @tparam LabeledTensorType
  * @tparam Func
  * @tparam N
@@ -53,6 +60,15 @@ public:
       merged_labels.insert(merged_labels.end(), rlt.labels().begin(), rlt.labels().end());
     }
     LabelLoopNest loop_nest{merged_labels};
+
+    const auto& ltensor = lhs_.tensor();
+    const auto  kind    = ltensor.kind();
+    if(kind != TensorBase::TensorKind::view && kind != TensorBase::TensorKind::unit_view &&
+       kind != TensorBase::TensorKind::lambda && ltensor.execution_context()->pg() == ec.pg()) {
+      execute_local(ec, loop_nest);
+      return;
+    }
+
     auto          lambda_no_translate = [&](const IndexVector& itval) {
       auto        ltensor = lhs_.tensor();
       IndexVector lblockid, rblockid[N];
@@ -104,7 +120,6 @@ public:
       func_(ltensor, lblockid, lbuf, rblockid, rbuf);
       ltensor.put(lblockid, lbuf);
     };
-    //@todo use a scheduler
     if(do_translate_) do_work(ec, loop_nest, lambda);
     else do_work(ec, loop_nest, lambda_no_translate);
   }
@@ -122,6 +137,54 @@ public:
   bool is_memory_barrier() const { return false; }
 
 protected:
+  /// Owner-computes execution: each rank only produces its own LHS blocks, in place
+  void execute_local(ExecutionContext& ec, LabelLoopNest& loop_nest) {
+    using TensorElType = typename LabeledTensorT::element_type;
+
+    auto          ltensor   = lhs_.tensor();
+    const auto&   ldist     = ltensor.distribution();
+    const Proc    me        = ec.pg().rank();
+    TensorElType* local_buf = ltensor.access_local_buf();
+
+    std::vector<TensorElType> lbuf;
+    std::vector<TensorElType> rbuf[N];
+    for(const auto& itval: loop_nest) {
+      IndexVector lblockid, rblockid[N];
+      auto        it = itval.begin();
+      lblockid.insert(lblockid.end(), it, it + lhs_.labels().size());
+      it += lhs_.labels().size();
+      for(size_t i = 0; i < N; i++) {
+        rblockid[i].insert(rblockid[i].end(), it, it + rhs_[i].labels().size());
+        it += rhs_[i].labels().size();
+        if(do_translate_) rblockid[i] = internal::translate_blockid(rblockid[i], rhs_[i]);
+      }
+      if(do_translate_) lblockid = internal::translate_blockid(lblockid, lhs_);
+      if(!ltensor.is_non_zero(lblockid)) { continue; }
+
+      auto [lproc, loffset] = ldist.locate(lblockid);
+      if(lproc != me) { continue; }
+
+      for(size_t i = 0; i < N; i++) {
+        const auto& rtensor_i = rhs_[i].tensor();
+        rbuf[i].resize(rtensor_i.block_size(rblockid[i]));
+        rtensor_i.get(rblockid[i], rbuf[i]);
+      }
+
+      const size_t  lsize = ltensor.block_size(lblockid);
+      TensorElType* block = local_buf + loffset.value();
+      if constexpr(std::is_invocable_v<Func&, Tensor<TensorElType>&, const IndexVector&,
+                                       span<TensorElType>, const IndexVector*,
+                                       std::vector<TensorElType>*>) {
+        func_(ltensor, lblockid, span<TensorElType>{block, lsize}, rblockid, rbuf);
+      }
+      else {
+        lbuf.assign(lsize, TensorElType{0});
+        func_(ltensor, lblockid, lbuf, rblockid, rbuf);
+        std::copy(lbuf.begin(), lbuf.end(), block);
+      }
+    }
+  }
+
   void fillin_labels() {
     using internal::fillin_tensor_label_from_map;
     using internal::update_fillin_map;
@@ -120,6 +120,20 @@ public:
    */
   virtual void fence(MemoryRegion& mr) = 0;
 
+  /**
+   * @brief Start combining accumulates on a memory region into per-rank batches. Batched
+   * accumulates are only guaranteed to be issued after end_batch() or a fence. The default
+   * implementation does not batch.
+   * @param mr Memory region whose accumulates are batched
+   */
+  virtual void begin_batch(MemoryRegion& mr) {}
+
+  /**
+   * @brief Issue all batched accumulates on a memory region and stop batching
+   * @param mr Memory region whose accumulates were batched
+   */
+  virtual void end_batch(MemoryRegion& mr) {}
+
   /**
    * Access a pointer at an offset from local buffer associated with a memory region.
    * @param mr Memory region being accessed
@@ -351,6 +365,23 @@ public:
     fence_impl();
   }
 
+  /**
+   * Batch accumulates on this memory region until end_batch()
+   * (see MemoryManager::begin_batch())
+   */
+  void begin_batch() {
+    EXPECTS(attached() || created());
+    mgr().begin_batch(*this);
+  }
+
+  /**
+   * Issue all batched accumulates on this memory region and stop batching
+   */
+  void end_batch() {
+    EXPECTS(attached() || created());
+    mgr().end_batch(*this);
+  }
+
   /**
    * Access local (i.e., buffer in this rank) data in this memory region
    * @param off Offset at which to access (in number of elements)
@@ -9,8 +9,14 @@
 #include <type_traits>
 #include <upcxx-extras/dist_array.hpp>
 #endif
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <tuple>
 #include <vector>
 
 //@todo Check visibility: public, private, protected
@@ -21,6 +27,19 @@
 
 namespace tamm {
 
+namespace detail {
+// TAMM_GA_ACC_BATCH_KB = 64(default)
+// Per target rank size (KiB) at which accumulates batched by MemoryManagerGA::begin_batch
+// are issued; larger accumulates are issued right away. 0 disables batching.
+static const size_t tamm_ga_acc_batch_kb = [] {
+  size_t batch_kb = 64;
+  if(const char* tammBatchKB = std::getenv("TAMM_GA_ACC_BATCH_KB")) {
+    batch_kb = std::atol(tammBatchKB);
+  }
+  return batch_kb;
+}();
+} // namespace detail
+
 class MemoryManagerGA;
 
 /**
@@ -60,6 +79,15 @@ private:
   int                  ga_;
   ElementType          eltype_;
   std::vector<int64_t> map_;
+
+  // Accumulates pending for one target rank (MemoryManagerGA::begin_batch)
+  struct AccBatch {
+    std::vector<std::pair<int64_t, int64_t>> ranges; // (lo, nelements), in the order of buf
+    std::vector<uint8_t>                     buf;
+  };
+  bool                    batching_ = false;
+  std::map<int, AccBatch> acc_batches_; // target rank -> pending accumulates
+  std::mutex              acc_batches_mutex_;
 #endif
 
   friend class MemoryManagerGA;
@@ -344,10 +372,37 @@ public:
 #if defined(USE_UPCXX)
     abort(); // assert this isn't being called
 #else
+    flush_batches(static_cast<MemoryRegionGA&>(mrb));
     ARMCI_AllFence();
 #endif
   }
 
+  /**
+   * @copydoc MemoryManager::begin_batch
+   *
+   * Accumulates to a target rank are issued when its batch reaches TAMM_GA_ACC_BATCH_KB,
+   * before any get/put on that rank's part of the region, and at end_batch(). Contiguous and
+   * nearby ranges are packed into a single NGA_Acc. Local buffer access does not see batched
+   * accumulates before end_batch(). Batches may be filled by several threads.
+   */
+  void begin_batch(MemoryRegion& mrb) override {
+#if !defined(USE_UPCXX)
+    MemoryRegionGA& mr = static_cast<MemoryRegionGA&>(mrb);
+    mr.batching_       = detail::tamm_ga_acc_batch_kb > 0;
+#endif
+  }
+
+  /**
+   * @copydoc MemoryManager::end_batch
+   */
+  void end_batch(MemoryRegion& mrb) override {
+#if !defined(USE_UPCXX)
+    MemoryRegionGA& mr = static_cast<MemoryRegionGA&>(mrb);
+    flush_batches(mr);
+    mr.batching_ = false;
+#endif
+  }
+
 protected:
   explicit MemoryManagerGA(ProcGroup pg
 #if defined(USE_UPCXX_DISTARRAY)
@@ -442,6 +497,7 @@ public:
 #endif
     upcxx::barrier(*team_);
 #else  // USE_UPCXX
+    flush_batches(mr);
     NGA_Destroy(mr.ga_);
     mr.ga_ = -1;
 #endif // USE_UPCXX
@@ -563,9 +619,10 @@ public:
 #endif
     f.wait();
 #else
-    const MemoryRegionGA& mr = static_cast<const MemoryRegionGA&>(mrb);
-    TAMM_SIZE             ioffset{mr.map_[proc.value()] + off.value()};
-    int64_t               lo = ioffset, hi = ioffset + nelements.value() - 1, ld = -1;
+    MemoryRegionGA& mr = static_cast<MemoryRegionGA&>(mrb);
+    flush_batch(mr, proc.value());
+    TAMM_SIZE ioffset{mr.map_[proc.value()] + off.value()};
+    int64_t   lo = ioffset, hi = ioffset + nelements.value() - 1, ld = -1;
     NGA_Get64(mr.ga_, &lo, &hi, to_buf, &ld);
 #endif
   }
@@ -628,6 +685,7 @@ public:
 #endif
     mr.fut_ = upcxx::when_all(mr.fut_, f);
 #else
+    flush_batch(mr, proc.value());
     TAMM_SIZE ioffset{mr.map_[proc.value()] + off.value()};
     int64_t   lo = ioffset, hi = ioffset + nelements.value() - 1, ld = -1;
 #endif
@@ -699,9 +757,10 @@ public:
       .wait();
 #endif // USE_UPCXX_DISTARRAY
 #else
-    const MemoryRegionGA& mr = static_cast<const MemoryRegionGA&>(mrb);
-    TAMM_SIZE             ioffset{mr.map_[proc.value()] + off.value()};
-    int64_t               lo = ioffset, hi = ioffset + nelements.value() - 1, ld = -1;
+    MemoryRegionGA& mr = static_cast<MemoryRegionGA&>(mrb);
+    flush_batch(mr, proc.value());
+    TAMM_SIZE ioffset{mr.map_[proc.value()] + off.value()};
+    int64_t   lo = ioffset, hi = ioffset + nelements.value() - 1, ld = -1;
     NGA_Put64(mr.ga_, &lo, &hi, const_cast<void*>(from_buf), &ld);
 #endif
   }
@@ -763,6 +822,7 @@ public:
 #endif
     mr.fut_ = upcxx::when_all(mr.fut_, f);
 #else
+    flush_batch(mr, proc.value());
     TAMM_SIZE ioffset{mr.map_[proc.value()] + off.value()};
     int64_t   lo = ioffset, hi = ioffset + nelements.value() - 1, ld = -1;
 #endif
@@ -995,23 +1055,18 @@ public:
    */
   void add(MemoryRegion& mrb, Proc proc, Offset off, Size nelements,
            const void* from_buf) override {
-    const MemoryRegionGA& mr = static_cast<const MemoryRegionGA&>(mrb);
 #if defined(USE_UPCXX)
     add_helper(mrb, proc, off, nelements, from_buf);
     pg_.add_op(proc.value());
 #else
-    TAMM_SIZE ioffset{mr.map_[proc.value()] + off.value()};
-    int64_t   lo = ioffset, hi = ioffset + nelements.value() - 1, ld = -1;
-    void*     alpha;
-    switch(mr.eltype_) {
-      case ElementType::single_precision: alpha = reinterpret_cast<void*>(&sp_alpha); break;
-      case ElementType::double_precision: alpha = reinterpret_cast<void*>(&dp_alpha); break;
-      case ElementType::single_complex: alpha = reinterpret_cast<void*>(&scp_alpha); break;
-      case ElementType::double_complex: alpha = reinterpret_cast<void*>(&dcp_alpha); break;
-      case ElementType::invalid:
-      default: UNREACHABLE();
+    MemoryRegionGA& mr = static_cast<MemoryRegionGA&>(mrb);
+    TAMM_SIZE       ioffset{mr.map_[proc.value()] + off.value()};
+    if(mr.batching_) {
+      batch_add(mr, proc.value(), ioffset, nelements.value(), from_buf);
+      return;
     }
-    NGA_Acc64(mr.ga_, &lo, &hi, const_cast<void*>(from_buf), &ld, alpha);
+    int64_t lo = ioffset, hi = ioffset + nelements.value() - 1, ld = -1;
+    NGA_Acc64(mr.ga_, &lo, &hi, const_cast<void*>(from_buf), &ld, acc_alpha(mr.eltype_));
 #endif
   }
 
@@ -1023,20 +1078,12 @@ public:
 #if defined(USE_UPCXX)
     abort(); // verify this API isn't being used.
 #else
-    const MemoryRegionGA& mr = static_cast<const MemoryRegionGA&>(mrb);
-    TAMM_SIZE             ioffset{mr.map_[proc.value()] + off.value()};
-    int64_t               lo = ioffset, hi = ioffset + nelements.value() - 1, ld = -1;
-    void*                 alpha;
-    switch(mr.eltype_) {
-      case ElementType::single_precision: alpha = reinterpret_cast<void*>(&sp_alpha); break;
-      case ElementType::double_precision: alpha = reinterpret_cast<void*>(&dp_alpha); break;
-      case ElementType::single_complex: alpha = reinterpret_cast<void*>(&scp_alpha); break;
-      case ElementType::double_complex: alpha = reinterpret_cast<void*>(&dcp_alpha); break;
-      case ElementType::invalid:
-      default: UNREACHABLE();
-    }
+    MemoryRegionGA& mr = static_cast<MemoryRegionGA&>(mrb);
+    flush_batch(mr, proc.value());
+    TAMM_SIZE ioffset{mr.map_[proc.value()] + off.value()};
+    int64_t   lo = ioffset, hi = ioffset + nelements.value() - 1, ld = -1;
     data_comm_handle->resetCompletionStatus();
-    NGA_NbAcc64(mr.ga_, &lo, &hi, const_cast<void*>(from_buf), &ld, alpha,
+    NGA_NbAcc64(mr.ga_, &lo, &hi, const_cast<void*>(from_buf), &ld, acc_alpha(mr.eltype_),
                 data_comm_handle->getDataHandlePtr());
 #endif
   }
@@ -1052,6 +1099,114 @@ public:
   }
 
 private:
+#if !defined(USE_UPCXX)
+  void* acc_alpha(ElementType eltype) {
+    switch(eltype) {
+      case ElementType::single_precision: return reinterpret_cast<void*>(&sp_alpha);
+      case ElementType::double_precision: return reinterpret_cast<void*>(&dp_alpha);
+      case ElementType::single_complex: return reinterpret_cast<void*>(&scp_alpha);
+      case ElementType::double_complex: return reinterpret_cast<void*>(&dcp_alpha);
+      case ElementType::invalid:
+      default: UNREACHABLE();
+    }
+  }
+
+  /// Queue an accumulate of @p nelements at global offset @p lo owned by @p proc
+  void batch_add(MemoryRegionGA& mr, int proc, int64_t lo, int64_t nelements,
+                 const void* from_buf) {
+    const size_t nbytes = nelements * get_element_size(mr.eltype_);
+    const size_t cap    = detail::tamm_ga_acc_batch_kb * 1024;
+    if(nbytes >= cap) {
+      // nothing to combine with, so skip the copy into the batch
+      int64_t hi = lo + nelements - 1, ld = -1;
+      NGA_Acc64(mr.ga_, &lo, &hi, const_cast<void*>(from_buf), &ld, acc_alpha(mr.eltype_));
+      return;
+    }
+    const uint8_t*              src = static_cast<const uint8_t*>(from_buf);
+    std::lock_guard<std::mutex> lock(mr.acc_batches_mutex_);
+    auto&                       batch = mr.acc_batches_[proc];
+    batch.buf.insert(batch.buf.end(), src, src + nbytes);
+    if(!batch.ranges.empty() && batch.ranges.back().first + batch.ranges.back().second == lo)
+      batch.ranges.back().second += nelements;
+    else batch.ranges.emplace_back(lo, nelements);
+
+    if(batch.buf.size() >= cap) flush_batch(mr, mr.acc_batches_.find(proc));
+  }
+
+  void flush_batch(MemoryRegionGA& mr, int proc) {
+    if(!mr.batching_) return;
+    std::lock_guard<std::mutex> lock(mr.acc_batches_mutex_);
+    auto                        it = mr.acc_batches_.find(proc);
+    if(it != mr.acc_batches_.end()) flush_batch(mr, it);
+  }
+
+  void flush_batches(MemoryRegionGA& mr) {
+    std::lock_guard<std::mutex> lock(mr.acc_batches_mutex_);
+    for(auto it = mr.acc_batches_.begin(); it != mr.acc_batches_.end();) it = flush_batch(mr, it);
+  }
+
+  /// Issue the batch at @p it and remove it; the caller holds acc_batches_mutex_
+  std::map<int, MemoryRegionGA::AccBatch>::iterator
+  flush_batch(MemoryRegionGA& mr, std::map<int, MemoryRegionGA::AccBatch>::iterator it) {
+    switch(mr.eltype_) {
+      case ElementType::single_precision: flush_batch<float>(mr, it->second, 1); break;
+      case ElementType::double_precision: flush_batch<double>(mr, it->second, 1); break;
+      case ElementType::single_complex: flush_batch<float>(mr, it->second, 2); break;
+      case ElementType::double_complex: flush_batch<double>(mr, it->second, 2); break;
+      case ElementType::invalid:
+      default: UNREACHABLE();
+    }
+    return mr.acc_batches_.erase(it);
+  }
+
+  /**
+   * Issue the accumulates of one batch. Ranges are sorted and merged as long as the merged
+   * span is at most twice the data it carries; gaps are padded with zeros, so each merged
+   * span is a single NGA_Acc. @p ncomp is the number of @p T values per element (2 for
+   * complex types).
+   */
+  template<typename T>
+  void flush_batch(MemoryRegionGA& mr, MemoryRegionGA::AccBatch& batch, int64_t ncomp) {
+    const T* data = reinterpret_cast<const T*>(batch.buf.data());
+    std::vector<std::tuple<int64_t, int64_t, size_t>> ranges; // (lo, nelements, offset in data)
+    size_t                                            off = 0;
+    for(const auto& [lo, n]: batch.ranges) {
+      ranges.emplace_back(lo, n, off);
+      off += n;
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    void*          alpha = acc_alpha(mr.eltype_);
+    std::vector<T> packed;
+    for(size_t i = 0; i < ranges.size();) {
+      int64_t lo = std::get<0>(ranges[i]), hi = lo + std::get<1>(ranges[i]) - 1, ld = -1;
+      int64_t payload = std::get<1>(ranges[i]);
+      size_t  j       = i + 1;
+      for(; j < ranges.size(); j++) {
+        const int64_t nhi = std::max(hi, std::get<0>(ranges[j]) + std::get<1>(ranges[j]) - 1);
+        if(nhi - lo + 1 > 2 * (payload + std::get<1>(ranges[j]))) break;
+        hi = nhi;
+        payload += std::get<1>(ranges[j]);
+      }
+      if(j == i + 1) {
+        NGA_Acc64(mr.ga_, &lo, &hi, const_cast<T*>(data + std::get<2>(ranges[i]) * ncomp), &ld,
+                  alpha);
+      }
+      else {
+        packed.assign((hi - lo + 1) * ncomp, T{0});
+        for(size_t k = i; k < j; k++) {
+          const auto& [rlo, rn, roff] = ranges[k];
+          T*       dst = packed.data() + (rlo - lo) * ncomp;
+          const T* src = data + roff * ncomp;
+          for(int64_t e = 0; e < rn * ncomp; e++) dst[e] += src[e];
+        }
+        NGA_Acc64(mr.ga_, &lo, &hi, packed.data(), &ld, alpha);
+      }
+      i = j;
+    }
+  }
+#endif
+
 #if defined(USE_UPCXX)
   upcxx::team* team_;
 #if defined(USE_UPCXX_DISTARRAY)
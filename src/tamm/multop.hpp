@@ -1,10 +1,13 @@
 #pragma once
 
-// #define MULTOP_PARTIAL_PARALLELIZE_RHS
-
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -15,6 +18,7 @@
 #include "tamm/kernels/assign.hpp"
 #include "tamm/kernels/multiply.hpp"
 #include "tamm/labeled_tensor.hpp"
+#include "tamm/lru_cache.hpp"
 #include "tamm/runtime_engine.hpp"
 #include "tamm/tensor.hpp"
 #include "tamm/types.hpp"
@@ -24,10 +28,305 @@ namespace tamm {
 
 template<typename T, typename LabeledTensorT1, typename LabeledTensorT2, typename LabeledTensorT3>
 class MultOp;
+
+namespace detail {
+// TAMM_MULTOP_KAGG_MB = 0(default, disabled)
+// Scratch budget (MiB per rank) for packing consecutive reduction tiles into
+// K-panels in MultOp::execute_bufacc.
+static const size_t tamm_multop_kagg_mb = [] {
+  size_t kagg_mb = 0;
+  if(const char* tammKaggMB = std::getenv("TAMM_MULTOP_KAGG_MB")) {
+    kagg_mb = std::atol(tammKaggMB);
+  }
+  return kagg_mb;
+}();
+
+// TAMM_MULTOP_SUMMA = 0(default, disabled)
+// Execute plain contractions over Distribution_Dense tensors with the SUMMA engine
+// (MultOp::execute_summa) instead of the owner-computes block loop.
+static const bool tamm_multop_summa = [] {
+  bool summa = false;
+  if(const char* tammSumma = std::getenv("TAMM_MULTOP_SUMMA")) { summa = std::atoi(tammSumma) > 0; }
+  return summa;
+}();
+
+// TAMM_MULTOP_SUMMA_REPL = 1(default)
+// Number of process layers the SUMMA engine splits the reduction across (2.5D).
+static const int tamm_multop_summa_repl = [] {
+  int repl = 1;
+  if(const char* tammSummaRepl = std::getenv("TAMM_MULTOP_SUMMA_REPL")) {
+    repl = std::max(1, std::atoi(tammSummaRepl));
+  }
+  return repl;
+}();
+
+// TAMM_MULTOP_REPLICATE_MB = 1(default)
+// MultOp::execute_bufacc operands up to this size (MiB) are replicated on every rank before the
+// block loop, instead of being fetched block by block for every C block. 0 disables it.
+static const size_t tamm_multop_replicate_mb = [] {
+  size_t repl_mb = 1;
+  if(const char* tammReplMB = std::getenv("TAMM_MULTOP_REPLICATE_MB")) {
+    repl_mb = std::atol(tammReplMB);
+  }
+  return repl_mb;
+}();
+
+// TAMM_MULTOP_SCREEN_THRESH = 0(default, disabled)
+// Block products with ||A_blk||*||B_blk|| below this threshold are skipped by
+// MultOp::execute_bufacc.
+static const double tamm_multop_screen_thresh = [] {
+  double thresh = 0.0;
+  if(const char* tammScreen = std::getenv("TAMM_MULTOP_SCREEN_THRESH")) {
+    thresh = std::atof(tammScreen);
+  }
+  return thresh;
+}();
+
+// TAMM_MULTOP_SPLIT_MIN_TILES = 4(default)
+// Minimum number of reduction tiles per rank when MultOp::execute_bufacc splits the
+// reduction of a C block across ranks (fewer C blocks than ranks). 0 disables the split.
+static const size_t tamm_multop_split_min_tiles = [] {
+  size_t min_tiles = 4;
+  if(const char* tammSplit = std::getenv("TAMM_MULTOP_SPLIT_MIN_TILES")) {
+    min_tiles = std::atol(tammSplit);
+  }
+  return min_tiles;
+}();
+
+// TAMM_MULTOP_DF_CACHE_MB = 0(default, disabled)
+// Panel cache (MiB per rank) of the three-index contraction engine MultOp::execute_df, used
+// for contractions of two three-index tensors over a single tiled reduction index.
+static const size_t tamm_multop_df_cache_mb = [] {
+  size_t df_mb = 0;
+  if(const char* tammDfMB = std::getenv("TAMM_MULTOP_DF_CACHE_MB")) {
+    df_mb = std::atol(tammDfMB);
+  }
+  return df_mb;
+}();
+
+// TAMM_MULTOP_DF_PANEL_MB = 64(default)
+// Size limit (MiB) of an A panel of MultOp::execute_df. Longer reductions are processed in
+// chunks of reduction tiles whose panels fit the limit. 0 removes the limit.
+static const size_t tamm_multop_df_panel_mb = [] {
+  size_t panel_mb = 64;
+  if(const char* tammDfPanelMB = std::getenv("TAMM_MULTOP_DF_PANEL_MB")) {
+    panel_mb = std::atol(tammDfPanelMB);
+  }
+  return panel_mb;
+}();
+
+// TAMM_MULTOP_ACC_CACHE_MB = 16(default)
+// Write-combining buffer (MiB per rank) for the output blocks of MultOp::execute's general
+// block loop. Contributions to the same C block are summed locally and accumulated once.
+// 0 disables it.
+static const size_t tamm_multop_acc_cache_mb = [] {
+  size_t acc_mb = 16;
+  if(const char* tammAccMB = std::getenv("TAMM_MULTOP_ACC_CACHE_MB")) {
+    acc_mb = std::atol(tammAccMB);
+  }
+  return acc_mb;
+}();
+} // namespace detail
+
+/**
+ * @brief Per-operation overrides of the MultOp execution strategies, see MultOp::set_options.
+ * Every field defaults to the corresponding TAMM_MULTOP_* environment setting.
+ */
+struct MultOpOptions {
+  /// Scratch budget (MiB per rank) for K-panel aggregation (TAMM_MULTOP_KAGG_MB)
+  size_t kagg_mb = detail::tamm_multop_kagg_mb;
+  /// Run eligible contractions with the SUMMA engine (TAMM_MULTOP_SUMMA)
+  bool summa = detail::tamm_multop_summa;
+  /// Number of SUMMA process layers (TAMM_MULTOP_SUMMA_REPL)
+  int summa_repl = detail::tamm_multop_summa_repl;
+  /// Size limit (MiB) of operands replicated on every rank (TAMM_MULTOP_REPLICATE_MB)
+  size_t replicate_mb = detail::tamm_multop_replicate_mb;
+  /// Norm threshold below which block products are skipped (TAMM_MULTOP_SCREEN_THRESH)
+  double screen_thresh = detail::tamm_multop_screen_thresh;
+  /// Minimum reduction tiles per rank when splitting a C block's reduction
+  /// (TAMM_MULTOP_SPLIT_MIN_TILES), 0 disables the split
+  size_t split_min_tiles = detail::tamm_multop_split_min_tiles;
+  /// Panel cache (MiB per rank) of the three-index engine (TAMM_MULTOP_DF_CACHE_MB)
+  size_t df_cache_mb = detail::tamm_multop_df_cache_mb;
+  /// Size limit (MiB) of an A panel of the three-index engine (TAMM_MULTOP_DF_PANEL_MB)
+  size_t df_panel_mb = detail::tamm_multop_df_panel_mb;
+  /// Write-combining buffer (MiB per rank) of the general block loop (TAMM_MULTOP_ACC_CACHE_MB)
+  size_t acc_cache_mb = detail::tamm_multop_acc_cache_mb;
+};
 } // namespace tamm
 
 namespace tamm::internal {
 
+/**
+ * @brief Rank-local copy of a whole (small) tensor, replicated once before an operation.
+ *
+ * Every rank packs the non-zero blocks it owns into a buffer laid out in loop-nest order and
+ * the buffers are summed over the process group, so the tensor is transferred in a single
+ * collective instead of one get per block read. Tensors whose buffer cannot be addressed
+ * locally are fetched by rank 0 before the reduction. Collective over the ranks of @p ec.
+ */
+template<typename T>
+class ReplicatedBlocks {
+public:
+  ReplicatedBlocks(ExecutionContext& ec, Tensor<T> tensor) {
+    size_t size = 0;
+    for(const IndexVector& blockid: tensor.loop_nest()) {
+      if(!tensor.is_non_zero(blockid)) continue;
+      const size_t bsize = tensor.block_size(blockid);
+      blocks_.emplace(blockid, std::make_pair(size, bsize));
+      size += bsize;
+    }
+
+    std::vector<T> local(size, T{0});
+    const T*       local_buf = internal::local_read_buf_if_owner(tensor, ec);
+    const Proc     me        = ec.pg().rank();
+    for(const auto& [blockid, pos]: blocks_) {
+      const auto [offset, bsize] = pos;
+      if(local_buf != nullptr) {
+        auto [proc, loffset] = tensor.distribution().locate(blockid);
+        if(proc == me) {
+          std::copy(local_buf + loffset.value(), local_buf + loffset.value() + bsize,
+                    local.data() + offset);
+        }
+      }
+      else if(me.value() == 0) { tensor.get(blockid, {local.data() + offset, bsize}); }
+    }
+    data_.resize(size);
+    ec.pg().allreduce(local.data(), data_.data(), static_cast<int>(size), ReduceOp::sum);
+  }
+
+  /// Copy block @p blockid into @p buff_span
+  void get(const IndexVector& blockid, span<T> buff_span) const {
+    const auto it = blocks_.find(blockid);
+    EXPECTS(it != blocks_.end());
+    const auto [offset, bsize] = it->second;
+    EXPECTS(buff_span.size() >= bsize);
+    std::copy(data_.begin() + offset, data_.begin() + offset + bsize, buff_span.data());
+  }
+
+private:
+  std::map<IndexVector, std::pair<size_t, size_t>> blocks_;
+  std::vector<T>                                   data_;
+};
+
+/**
+ * @brief Write-combining buffer for accumulations into a tensor. Contributions to the same
+ * block are summed locally and each block is accumulated into the tensor once, when it is
+ * evicted (least recently used first) to stay within the byte budget or on flush().
+ */
+template<typename T>
+class AccumulationCache {
+public:
+  AccumulationCache(Tensor<T> tensor, size_t max_bytes):
+    tensor_{tensor}, max_bytes_{max_bytes} {}
+
+  AccumulationCache(const AccumulationCache&)            = delete;
+  AccumulationCache& operator=(const AccumulationCache&) = delete;
+
+  ~AccumulationCache() { flush(); }
+
+  /// Add @p buff_span to the pending contribution of block @p blockid
+  void add(const IndexVector& blockid, span<T> buff_span) {
+    const size_t bsize = buff_span.size();
+    auto         it    = blocks_.find(blockid);
+    if(it != blocks_.end()) {
+      auto& entry = it->second;
+      EXPECTS(entry.buf.size() == bsize);
+      for(size_t i = 0; i < bsize; i++) entry.buf[i] += buff_span[i];
+      lru_.erase(entry.stamp);
+      entry.stamp       = clock_++;
+      lru_[entry.stamp] = blockid;
+      num_combined_++;
+      return;
+    }
+    if(bsize * sizeof(T) > max_bytes_) {
+      tensor_.add(blockid, buff_span);
+      return;
+    }
+    while(bytes_ + bsize * sizeof(T) > max_bytes_) evict(lru_.begin()->second);
+    auto& entry = blocks_[blockid];
+    entry.buf.assign(buff_span.data(), buff_span.data() + bsize);
+    entry.stamp       = clock_++;
+    lru_[entry.stamp] = blockid;
+    bytes_ += bsize * sizeof(T);
+  }
+
+  /// Accumulate all pending blocks into the tensor
+  void flush() {
+    for(auto& [blockid, entry]: blocks_) {
+      tensor_.add(blockid, {entry.buf.data(), entry.buf.size()});
+    }
+    blocks_.clear();
+    lru_.clear();
+    bytes_ = 0;
+  }
+
+  /// Number of contributions merged into an already pending block (accumulates saved)
+  size_t num_combined() const { return num_combined_; }
+
+private:
+  struct Entry {
+    std::vector<T> buf;
+    uint64_t       stamp;
+  };
+
+  void evict(const IndexVector& blockid) {
+    auto it = blocks_.find(blockid);
+    EXPECTS(it != blocks_.end());
+    auto& entry = it->second;
+    tensor_.add(blockid, {entry.buf.data(), entry.buf.size()});
+    bytes_ -= entry.buf.size() * sizeof(T);
+    lru_.erase(entry.stamp);
+    blocks_.erase(it);
+  }
+
+  Tensor<T>                       tensor_;
+  size_t                          max_bytes_;
+  size_t                          bytes_{0};
+  size_t                          num_combined_{0};
+  uint64_t                        clock_{0};
+  std::map<IndexVector, Entry>    blocks_;
+  std::map<uint64_t, IndexVector> lru_; // stamp -> blockid, oldest first
+};
+
+/**
+ * @brief Recompute the per-block norms of @p tensor if they are stale on any rank. Each rank
+ * computes the norms of the blocks it owns and the results are combined over the process
+ * group, so this is collective over @p ec.
+ */
+template<typename T>
+void update_block_norms(ExecutionContext& ec, Tensor<T> tensor) {
+  int stale = tensor.base_ptr()->block_norms_valid() ? 0 : 1;
+  int any_stale{0};
+  ec.pg().allreduce(&stale, &any_stale, 1, ReduceOp::max);
+  if(!any_stale) return;
+
+  const auto&              dist = tensor.distribution();
+  const Proc               me   = ec.pg().rank();
+  std::vector<IndexVector> blockids;
+  std::vector<double>      nrm2;
+  std::vector<T>           buf;
+  for(const auto& blockid: tensor.loop_nest()) {
+    if(!tensor.is_non_zero(blockid)) continue;
+    blockids.push_back(blockid);
+    double val = 0.0;
+    if(std::get<0>(dist.locate(blockid)) == me) {
+      const size_t bsize = tensor.block_size(blockid);
+      buf.resize(bsize);
+      tensor.get(blockid, {buf.data(), bsize});
+      for(const auto& x: buf) val += std::norm(x);
+    }
+    nrm2.push_back(val);
+  }
+  std::vector<double> global_nrm2(nrm2.size());
+  ec.pg().allreduce(nrm2.data(), global_nrm2.data(), static_cast<int>(nrm2.size()),
+                    ReduceOp::sum);
+
+  std::map<IndexVector, double> norms;
+  for(size_t i = 0; i < blockids.size(); i++) norms[blockids[i]] = std::sqrt(global_nrm2[i]);
+  tensor.base_ptr()->set_block_norms(std::move(norms));
+}
+
 template<typename T, typename LabeledTensorT1, typename LabeledTensorT2, typename LabeledTensorT3>
 struct MultOpPlanBase {
   using MultOpT = MultOp<T, LabeledTensorT1, LabeledTensorT2, LabeledTensorT3>;
@@ -250,6 +549,32 @@ public:
 
   bool is_assign() const { return is_assign_; }
 
+  /**
+   * @brief Set a per-element epilogue applied to the computed update of each C block before it
+   * is added to C, e.g. C(i,a) += A(i,k) * B(k,a) followed by division by denominators. The
+   * update of a C block may be accumulated from several partial contributions, so the epilogue
+   * must be linear in the value.
+   */
+  MultOp& set_epilogue(ElementEpilogue<typename LabeledTensorT1::element_type> epilogue) {
+    epilogue_ = std::move(epilogue);
+    return *this;
+  }
+
+  const ElementEpilogue<typename LabeledTensorT1::element_type>& epilogue() const {
+    return epilogue_;
+  }
+
+  /**
+   * @brief Override the execution strategies (K-panel aggregation, ...) of this operation. The
+   * defaults are taken from the TAMM_MULTOP_* environment variables.
+   */
+  MultOp& set_options(const MultOpOptions& options) {
+    options_ = options;
+    return *this;
+  }
+
+  const MultOpOptions& options() const { return options_; }
+
   OpType op_type() const override { return OpType::mult; }
 
   OpList canonicalize() const override {
@@ -261,6 +586,8 @@ public:
       auto assign_op = (lhs = (TensorElType1) 0);
       result.push_back(assign_op.clone());
       MultOp n_op{lhs_, alpha_, rhs1_, rhs2_, false};
+      n_op.set_epilogue(epilogue_);
+      n_op.set_options(options_);
       result.push_back(n_op.clone());
     }
     else { result.push_back((*this).clone()); }
@@ -268,6 +595,17 @@ public:
     return result;
   }
 
+  /// Same contraction assigning C instead of adding to it, when every block of C is an output
+  std::shared_ptr<Op> first_write_form() const override {
+    if(internal::is_slicing(lhs_) || internal::has_duplicates(lhs_.labels())) return nullptr;
+    for(const auto& lbl: lhs_.labels()) {
+      if(lbl.is_dependent()) return nullptr;
+    }
+    auto op        = std::make_shared<MultOp>(*this);
+    op->is_assign_ = true;
+    return op;
+  }
+
   std::shared_ptr<Op> clone() const override { return std::shared_ptr<Op>(new MultOp{*this}); }
 
   using TensorElType1 = typename LabeledTensorT1::element_type;
@@ -275,7 +613,6 @@ public:
   using TensorElType3 = typename LabeledTensorT3::element_type;
 
   void execute(ExecutionContext& ec, ExecutionHW hw = ExecutionHW::CPU) override {
-    EXPECTS(!is_assign_);
     auto& oprof = tamm::OpProfiler::instance();
 
     using TensorElType = typename LabeledTensorT1::element_type;
@@ -286,8 +623,17 @@ public:
     LabelLoopNest loop_nest{all_labels};
 
     std::vector<AddBuf<TensorElType1, TensorElType2, TensorElType3>*> add_bufs;
+    // Several (A,B) block pairs of one task list can hit the same C block. Under the
+    // scheduler (level barrier after the op) combine them locally and flush once at the end.
+    std::unique_ptr<internal::AccumulationCache<TensorElType1>> acc_cache;
+#ifndef DO_NB
+    if(options_.acc_cache_mb > 0 && ec.ac().ac_ != nullptr) {
+      acc_cache = std::make_unique<internal::AccumulationCache<TensorElType1>>(
+        lhs_.tensor(), options_.acc_cache_mb * 1024 * 1024);
+    }
+#endif
     // function to compute one block
-    auto lambda = [=, &oprof, &add_bufs, &loop_nest, &ec](const IndexVector itval) {
+    auto lambda = [=, &oprof, &add_bufs, &loop_nest, &ec, &acc_cache](const IndexVector itval) {
       auto ctensor = lhs_.tensor();
       auto atensor = rhs1_.tensor();
       auto btensor = rhs2_.tensor();
@@ -417,7 +763,9 @@ public:
         cbuf = static_cast<TensorElType1*>(memHostPool.allocate(csize * sizeof(TensorElType1)));
         abuf = static_cast<TensorElType2*>(memHostPool.allocate(asize * sizeof(TensorElType2)));
         bbuf = static_cast<TensorElType3*>(memHostPool.allocate(bsize * sizeof(TensorElType3)));
-        std::memset(static_cast<void*>(cbuf), 0, csize * sizeof(TensorElType1));
+        // on the CPU block_multiply overwrites cbuf; the GPU result is added onto it
+        if(hw == ExecutionHW::GPU)
+          std::memset(static_cast<void*>(cbuf), 0, csize * sizeof(TensorElType1));
 
         // get inputs
 #ifdef DO_NB
@@ -519,6 +867,11 @@ public:
 #endif
         }
 
+        if(epilogue_) {
+          internal::apply_epilogue(epilogue_, ab->cbuf_, cdims,
+                                   ctensor.block_offsets(translated_cblockid));
+        }
+
 #if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
         memDevicePool.deallocate(th_a, asize * sizeof(TensorElType2));
         memDevicePool.deallocate(th_b, bsize * sizeof(TensorElType3));
@@ -531,7 +884,8 @@ public:
         {
           TimerGuard tg_get{&oprof.multOpAddTime};
           // add the computed update to the tensor
-          ctensor.add(translated_cblockid, {ab->cbuf_, csize});
+          if(acc_cache) acc_cache->add(translated_cblockid, {ab->cbuf_, csize});
+          else ctensor.add(translated_cblockid, {ab->cbuf_, csize});
         }
         delete ab;
         add_bufs.clear();
@@ -551,17 +905,36 @@ public:
       }
     }
 
-    if(1 && (lhs_.tensor().is_dense() /* && !lhs_.tensor().has_spin() */) &&
-       (rhs1_.tensor().is_dense() /* && !rhs1_.tensor().has_spin() */) &&
-       (rhs2_.tensor().is_dense() /* && !rhs2_.tensor().has_spin() */) && !has_sparse_labels &&
-       !lhs_.labels().empty() && lhs_.tensor().execution_context()->pg() == ec.pg()
-       //    rhs1_.tensor().execution_context()->pg() == ec.pg() &&
-       //    rhs2_.tensor().execution_context()->pg() == ec.pg()
-    ) {
-      execute_bufacc(ec, hw);
-    }
+    const bool use_bufacc =
+      (lhs_.tensor().is_dense() /* && !lhs_.tensor().has_spin() */) &&
+      (rhs1_.tensor().is_dense() /* && !rhs1_.tensor().has_spin() */) &&
+      (rhs2_.tensor().is_dense() /* && !rhs2_.tensor().has_spin() */) && !has_sparse_labels &&
+      !lhs_.labels().empty() && lhs_.tensor().execution_context()->pg() == ec.pg();
+    //    rhs1_.tensor().execution_context()->pg() == ec.pg() &&
+    //    rhs2_.tensor().execution_context()->pg() == ec.pg()
+
+    // an assign accumulates into a zeroed C (execute_bufacc decides per strategy)
+    if(is_assign_ && !use_bufacc) zero_lhs(ec);
+
+    // batch the accumulates of all C blocks per target rank; issued before the op returns. Only
+    // under the scheduler (level barrier after the op): without an atomic counter, do_work ends
+    // with a barrier that would let other ranks read C before the batches are issued.
+    const bool acc_batch = ec.ac().ac_ != nullptr;
+    if(acc_batch) lhs_.tensor().begin_acc_batch();
+    // with TAMM_KERNEL_AUTOTUNE only rank 0 times the block product variants, its decisions
+    // are broadcast after the op so that every rank runs the same kernel for a block shape
+    auto& tuner = kernels::MultKernelTuner::instance();
+    if(detail::tamm_kernel_autotune) tuner.set_tuning(ec.pg().rank() == 0);
+    if(use_bufacc) { execute_bufacc(ec, hw); }
     else { do_work(ec, loop_nest, lambda); }
 
+    {
+      TimerGuard tg_add{&oprof.multOpAddTime};
+      if(acc_cache) acc_cache->flush();
+      if(acc_batch) lhs_.tensor().end_acc_batch();
+    }
+    if(detail::tamm_kernel_autotune) tuner.sync(ec.pg());
+
 #ifdef DO_NB
     {
       TimerGuard tg_add{&multOpAddTime};
@@ -577,7 +950,6 @@ public:
   }
 
   void execute_bufacc(ExecutionContext& ec, ExecutionHW hw = ExecutionHW::CPU) {
-    EXPECTS(!is_assign_);
     auto& oprof         = tamm::OpProfiler::instance();
     using TensorElType1 = typename LabeledTensorT1::element_type;
     using TensorElType2 = typename LabeledTensorT2::element_type;
@@ -631,10 +1003,48 @@ public:
       else rhs2_map_reduction.push_back(-1);
     }
 
+    // K-panel aggregation applies to plain contractions: no batch (Hadamard) or
+    // single-operand reduction labels, no repeated labels, same element types.
+    constexpr bool kagg_types = std::is_same_v<T, TensorElType1> &&
+                                std::is_same_v<T, TensorElType2> &&
+                                std::is_same_v<T, TensorElType3>;
+    IntLabelVec    kagg_aouter_labels, kagg_bouter_labels, kagg_inner_labels;
+    bool           use_kagg = false;
+    if constexpr(kagg_types) {
+      use_kagg = hw == ExecutionHW::CPU && options_.kagg_mb > 0 &&
+                 matrix_label_groups(kagg_aouter_labels, kagg_bouter_labels, kagg_inner_labels);
+    }
+
+    if constexpr(kagg_types) {
+      const auto dense = [](const auto& ltensor) {
+        return ltensor.tensor().distribution().kind() == DistributionKind::dense;
+      };
+      IntLabelVec aouter, bouter, inner;
+      if(hw == ExecutionHW::CPU && options_.summa && dense(lhs_) && dense(rhs1_) &&
+         dense(rhs2_) && matrix_label_groups(aouter, bouter, inner)) {
+        if(is_assign_) zero_lhs(ec);
+        execute_summa(ec, aouter, bouter, inner);
+        return;
+      }
+      // two three-index tensors contracted over one long (Cholesky / DF) index
+      if(hw == ExecutionHW::CPU && options_.df_cache_mb > 0 &&
+         rhs1_.labels().size() == 3 && rhs2_.labels().size() == 3 &&
+         matrix_label_groups(aouter, bouter, inner) && inner.size() == 1) {
+        const auto qpos =
+          std::find(rhs1_int_labels_.begin(), rhs1_int_labels_.end(), inner[0]) -
+          rhs1_int_labels_.begin();
+        if(rhs1_.labels()[qpos].tiled_index_space().num_tiles() > 1) {
+          if(is_assign_) zero_lhs(ec);
+          execute_df(ec, aouter, bouter, inner);
+          return;
+        }
+      }
+    }
+
     // IndexLabelVec reduction_lbls{reduction.begin(), reduction.end()};
-#if defined(MULTOP_PARTIAL_PARALLELIZE_RHS)
-    int64_t n_lhs_blocks, nranks_per_lhs_block, lhs_counter;
-#endif
+    // reduction split: this rank computes every red_split-th reduction tile, starting at
+    // red_slot, of the C blocks it is given (see the cost model below)
+    size_t red_split = 1, red_slot = 0;
 
     auto& memHostPool = RMMMemoryManager::getInstance().getHostMemoryPool();
 #if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
@@ -644,6 +1054,30 @@ public:
     gpuStream_t thandle{};
 #endif
 
+    // blocks of small operands are kept by this rank once read
+    const size_t replicate_bytes = options_.replicate_mb * 1024 * 1024;
+    const bool   replicate_a =
+      replicate_bytes > 0 &&
+      static_cast<size_t>(rhs1_.tensor().size()) * sizeof(TensorElType2) <= replicate_bytes;
+    const bool replicate_b =
+      replicate_bytes > 0 &&
+      static_cast<size_t>(rhs2_.tensor().size()) * sizeof(TensorElType3) <= replicate_bytes;
+    std::unique_ptr<internal::ReplicatedBlocks<TensorElType2>> arepl;
+    std::unique_ptr<internal::ReplicatedBlocks<TensorElType3>> brepl;
+    if(replicate_a)
+      arepl = std::make_unique<internal::ReplicatedBlocks<TensorElType2>>(ec, rhs1_.tensor());
+    if(replicate_b)
+      brepl = std::make_unique<internal::ReplicatedBlocks<TensorElType3>>(ec, rhs2_.tensor());
+
+    // norm-based screening of block products
+    const double screen_thresh = options_.screen_thresh;
+    if(screen_thresh > 0.0) {
+      internal::update_block_norms(ec, rhs1_.tensor());
+      internal::update_block_norms(ec, rhs2_.tensor());
+    }
+    const auto& anorms = rhs1_.tensor().base_ptr()->block_norms();
+    const auto& bnorms = rhs2_.tensor().base_ptr()->block_norms();
+
     // function to compute one block
     auto lambda = [&](const IndexVector itval) { // i, j
       auto ctensor = lhs_.tensor();
@@ -659,7 +1093,9 @@ public:
       const size_t   csize = ctensor.block_size(translated_cblockid);
       TensorElType1* cbuf{nullptr};
       cbuf = static_cast<TensorElType1*>(memHostPool.allocate(csize * sizeof(TensorElType1)));
-      std::memset(static_cast<void*>(cbuf), 0, static_cast<size_t>(csize * sizeof(TensorElType1)));
+      // on the CPU the first block product assigns cbuf; the GPU result is added onto it
+      bool cfilled = hw == ExecutionHW::GPU;
+      if(cfilled) std::memset(static_cast<void*>(cbuf), 0, csize * sizeof(TensorElType1));
       const auto& cdims = ctensor.block_dims(translated_cblockid);
 
       SizeVec cdims_sz;
@@ -677,16 +1113,38 @@ public:
         new AddBuf<TensorElType1, TensorElType2, TensorElType3>{ctensor, {}, translated_cblockid};
 #endif
 
+      // [aouter, bouter] layout of the K-panel GEMM result for this C block
+      SizeVec        kagg_aouter_dims, kagg_bouter_dims;
+      int            kagg_M = 1, kagg_N = 1;
+      TensorElType1* kagg_cinter{nullptr};
+
+      std::unique_ptr<kernels::KPanelGemm<TensorElType1>> kagg;
+      if constexpr(kagg_types) {
+        if(use_kagg) {
+          auto dim_of = [&](IntLabel l) {
+            return cdims_sz[std::find(lhs_int_labels_.begin(), lhs_int_labels_.end(), l) -
+                            lhs_int_labels_.begin()];
+          };
+          for(const auto l: kagg_aouter_labels) {
+            kagg_aouter_dims.push_back(dim_of(l));
+            kagg_M *= static_cast<int>(kagg_aouter_dims.back().value());
+          }
+          for(const auto l: kagg_bouter_labels) {
+            kagg_bouter_dims.push_back(dim_of(l));
+            kagg_N *= static_cast<int>(kagg_bouter_dims.back().value());
+          }
+          kagg_cinter =
+            static_cast<TensorElType1*>(memHostPool.allocate(csize * sizeof(TensorElType1)));
+          kagg = std::make_unique<kernels::KPanelGemm<TensorElType1>>(
+            alpha_, kagg_M, kagg_N, options_.kagg_mb * 1024 * 1024, kagg_cinter);
+        }
+      }
+
       {
         // LabelLoopNest inner_loop{reduction_lbls};
         LabelLoopNest inner_loop{reduction_labels};
 
         int loop_counter = 0;
-#if defined(MULTOP_PARTIAL_PARALLELIZE_RHS)
-        nranks_per_lhs_block = (ec.pg().size().value() / n_lhs_blocks) + 1 -
-                               (lhs_counter >= (ec.pg().size().value() % n_lhs_blocks));
-#endif
-
         TensorElType1* cbuf_dev_ptr{nullptr};
         TensorElType1* cbuf_tmp_dev_ptr{nullptr};
 #if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
@@ -732,11 +1190,35 @@ public:
           const auto translated_bblockid = internal::translate_blockid(b_block_id, rhs2_);
           if(!btensor.is_non_zero(translated_bblockid)) continue;
 
-#if defined(MULTOP_PARTIAL_PARALLELIZE_RHS)
-          if(!(loop_counter++ % nranks_per_lhs_block == ec.pg().rank().value() / n_lhs_blocks)) {
+          if(red_split > 1 && static_cast<size_t>(loop_counter++) % red_split != red_slot) {
             continue;
           }
-#endif
+          if(screen_thresh > 0.0) {
+            const auto        ablk_dims = atensor.block_dims(translated_ablockid);
+            const auto        bblk_dims = btensor.block_dims(translated_bblockid);
+            double            flops     = 2.0 * csize;
+            std::vector<bool> counted(reduction_labels.size(), false);
+            for(size_t i = 0; i < rhs1_map_reduction.size(); i++) {
+              const int r = rhs1_map_reduction[i];
+              if(r != -1 && !counted[r]) {
+                counted[r] = true;
+                flops *= ablk_dims[i];
+              }
+            }
+            for(size_t i = 0; i < rhs2_map_reduction.size(); i++) {
+              const int r = rhs2_map_reduction[i];
+              if(r != -1 && !counted[r]) {
+                counted[r] = true;
+                flops *= bblk_dims[i];
+              }
+            }
+            oprof.multOpTotalFlops += flops;
+            if(anorms.at(translated_ablockid) * bnorms.at(translated_bblockid) < screen_thresh) {
+              oprof.multOpScreenedFlops += flops;
+              continue;
+            }
+          }
+
           // compute block size and allocate buffers for abuf and bbuf
           const size_t asize = atensor.block_size(translated_ablockid);
           const size_t bsize = btensor.block_size(translated_bblockid);
@@ -751,8 +1233,16 @@ public:
 
           {
             TimerGuard tg_get{&oprof.multOpGetTime};
-            atensor.nb_get(translated_ablockid, {abuf, asize}, &a_nbhandle);
-            btensor.nb_get(translated_bblockid, {bbuf, bsize}, &b_nbhandle);
+            if(arepl) {
+              arepl->get(translated_ablockid, {abuf, asize});
+              a_nbhandle.setCompletionStatus();
+            }
+            else atensor.nb_get(translated_ablockid, {abuf, asize}, &a_nbhandle);
+            if(brepl) {
+              brepl->get(translated_bblockid, {bbuf, bsize});
+              b_nbhandle.setCompletionStatus();
+            }
+            else btensor.nb_get(translated_bblockid, {bbuf, bsize}, &b_nbhandle);
           }
           {
             TimerGuard tg_wait{&multOpWaitTime};
@@ -762,11 +1252,13 @@ public:
 #else
           {
             TimerGuard tg_get{&oprof.multOpGetTime};
-            atensor.get(translated_ablockid, {abuf, asize});
+            if(arepl) arepl->get(translated_ablockid, {abuf, asize});
+            else atensor.get(translated_ablockid, {abuf, asize});
           }
           {
             TimerGuard tg_get{&oprof.multOpGetTime};
-            btensor.get(translated_bblockid, {bbuf, bsize});
+            if(brepl) brepl->get(translated_bblockid, {bbuf, bsize});
+            else btensor.get(translated_bblockid, {bbuf, bsize});
           }
 #endif
           const auto& adims = atensor.block_dims(translated_ablockid);
@@ -779,6 +1271,38 @@ public:
           for(const auto v: adims) { adims_sz.push_back(v); }
           for(const auto v: bdims) { bdims_sz.push_back(v); }
 
+          if(kagg) {
+            SizeVec inner_dims;
+            int     K = 1;
+            for(const auto l: kagg_inner_labels) {
+              inner_dims.push_back(
+                adims_sz[std::find(rhs1_int_labels_.begin(), rhs1_int_labels_.end(), l) -
+                         rhs1_int_labels_.begin()]);
+              K *= static_cast<int>(inner_dims.back().value());
+            }
+            SizeVec ainter_dims{kagg_aouter_dims};
+            ainter_dims.insert(ainter_dims.end(), inner_dims.begin(), inner_dims.end());
+            IntLabelVec ainter_labels{kagg_aouter_labels};
+            ainter_labels.insert(ainter_labels.end(), kagg_inner_labels.begin(),
+                                 kagg_inner_labels.end());
+            SizeVec binter_dims{inner_dims};
+            binter_dims.insert(binter_dims.end(), kagg_bouter_dims.begin(), kagg_bouter_dims.end());
+            IntLabelVec binter_labels{kagg_inner_labels};
+            binter_labels.insert(binter_labels.end(), kagg_bouter_labels.begin(),
+                                 kagg_bouter_labels.end());
+            {
+              TimerGuard tg_dgemm{&oprof.multOpDgemmTime};
+              if constexpr(kagg_types) {
+                kagg->pack(abuf, adims_sz, rhs1_int_labels_, ainter_dims, ainter_labels, bbuf,
+                           bdims_sz, rhs2_int_labels_, binter_dims, binter_labels, K);
+              }
+            }
+            slc++;
+            memHostPool.deallocate(abuf, asize * sizeof(TensorElType2));
+            memHostPool.deallocate(bbuf, bsize * sizeof(TensorElType3));
+            continue;
+          }
+
           // A*B
           {
 #if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
@@ -799,7 +1323,9 @@ public:
                 abuf_dev, bbuf_dev,
 #endif
                 thandle, alpha_, abuf, adims_sz, rhs1_int_labels_, bbuf, bdims_sz, rhs2_int_labels_,
-                cscale, cbuf, cdims_sz, lhs_int_labels_, hw, false, cbuf_dev_ptr, cbuf_tmp_dev_ptr);
+                cscale, cbuf, cdims_sz, lhs_int_labels_, hw, !cfilled, cbuf_dev_ptr,
+                cbuf_tmp_dev_ptr);
+              cfilled = true;
             }
 
 #if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
@@ -815,7 +1341,30 @@ public:
           memHostPool.deallocate(bbuf, bsize * sizeof(TensorElType3));
         } // end of reduction loop
 
+        if constexpr(kagg_types) {
+          if(kagg) {
+            {
+              TimerGuard tg_dgemm{&oprof.multOpDgemmTime};
+              kagg->flush();
+            }
+            if(kagg->touched()) {
+              IntLabelVec cinter_labels{kagg_aouter_labels};
+              cinter_labels.insert(cinter_labels.end(), kagg_bouter_labels.begin(),
+                                   kagg_bouter_labels.end());
+              SizeVec cinter_dims{kagg_aouter_dims};
+              cinter_dims.insert(cinter_dims.end(), kagg_bouter_dims.begin(),
+                                 kagg_bouter_dims.end());
+              kernels::assign<TensorElType1>(cbuf, cdims_sz, lhs_int_labels_, TensorElType1{1},
+                                             kagg_cinter, cinter_dims, cinter_labels, true);
+              cfilled = true;
+            }
+            kagg.reset();
+            memHostPool.deallocate(kagg_cinter, csize * sizeof(TensorElType1));
+          }
+        }
+
         // add the computed update to the tensor
+        if(!cfilled) std::memset(static_cast<void*>(cbuf), 0, csize * sizeof(TensorElType1));
         {
 #if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
           // copy to host
@@ -836,7 +1385,17 @@ public:
             memHostPool.deallocate(cbuf_tmp, csize * sizeof(TensorElType1));
           }
 #endif
-          {
+          if(epilogue_) {
+            internal::apply_epilogue(epilogue_, cbuf, cdims,
+                                     ctensor.block_offsets(translated_cblockid));
+          }
+          // an assign computed by this rank alone puts the whole block, zeros included;
+          // otherwise there is nothing to add if every block product was screened out
+          if(is_assign_ && red_split == 1) {
+            TimerGuard tg_add{&oprof.multOpAddTime};
+            ctensor.put(translated_cblockid, {cbuf, csize});
+          }
+          else if(slc > 0 || screen_thresh <= 0.0) {
             TimerGuard tg_add{&oprof.multOpAddTime};
             ctensor.add(translated_cblockid, {cbuf, csize});
           }
@@ -858,33 +1417,41 @@ public:
 
 #if 0 && 6
             do_work(ec, lhs_loop_nest, lambda);
-#elif defined(MULTOP_PARTIAL_PARALLELIZE_RHS)
-    {
-      const auto& ldist        = lhs_.tensor().distribution();
-      int         me           = ec.pg().rank().value();
-      int         nranks       = ec.pg().rank().value();
-      int         n_lhs_blocks = 0;
-      for(const auto& lblockid: lhs_loop_nest) {
-        if(lhs_.tensor().is_non_zero(lblockid)) { n_lhs_blocks += 1; }
-      }
-      int lhs_counter = 0;
-
-      for(const auto& lblockid: lhs_loop_nest) {
-        if(!lhs_.tensor().is_non_zero(lblockid)) { continue; }
-        lhs_counter += 1;
-        if(std::get<0>(ldist.locate(lblockid)) == me % n_lhs_blocks) {
-          nranks_per_lhs_block =
-            (nranks / n_lhs_blocks) + 1 - (lhs_counter >= (nranks % n_lhs_blocks));
-          lambda(lblockid);
-          // multOpGetTime += 1;
-        }
-      }
-    }
 #else
     {
       const auto& ldist = lhs_.tensor().distribution();
       Proc        me    = ec.pg().rank();
 
+      // Cost model: with fewer non-zero C blocks than ranks, owner-computes leaves ranks idle.
+      // Then each C block is shared by a group of ranks that split its reduction tiles and
+      // accumulate their partial C blocks, as long as every rank keeps at least
+      // split_min_tiles (TAMM_MULTOP_SPLIT_MIN_TILES) reduction tiles to amortize the extra add.
+      const size_t             nranks = ec.pg().size().value();
+      size_t                   split  = 1;
+      std::vector<IndexVector> lhs_blocks;
+      if(options_.split_min_tiles > 0 && nranks > 1) {
+        size_t n_red_tiles = 1;
+        for(const auto& lbl: reduction_labels) n_red_tiles *= lbl.tiled_index_space().num_tiles();
+        for(const auto& lblockid: lhs_loop_nest) {
+          if(lhs_blocks.size() >= nranks) break;
+          if(lhs_.tensor().is_non_zero(internal::translate_blockid(lblockid, lhs_)))
+            lhs_blocks.push_back(lblockid);
+        }
+        if(!lhs_blocks.empty() && lhs_blocks.size() < nranks) {
+          split = std::min(nranks / lhs_blocks.size(), n_red_tiles / options_.split_min_tiles);
+        }
+      }
+
+      if(split > 1) {
+        // the partial C blocks of an assign are accumulated into a zeroed C
+        if(is_assign_) zero_lhs(ec);
+        const size_t n_out = lhs_blocks.size();
+        red_split          = split;
+        red_slot           = static_cast<size_t>(me.value()) / n_out;
+        if(red_slot < red_split) lambda(lhs_blocks[static_cast<size_t>(me.value()) % n_out]);
+        return;
+      }
+
       for(const auto& lblockid: lhs_loop_nest) {
         const auto translated_lblockid = internal::translate_blockid(lblockid, lhs_);
         if(lhs_.tensor().is_non_zero(translated_lblockid) &&
@@ -896,6 +1463,478 @@ public:
 #endif
   }
 
+  /**
+   * @brief SUMMA-style execution of a plain contraction on Distribution_Dense tensors.
+   *
+   * The contraction is treated as a matrix product over tile tuples: rows are the tiles of
+   * the aouter labels, columns the tiles of the bouter labels and the reduction runs over the
+   * tiles of the inner labels. The ranks form @p repl layers of a pr x pc grid. For every
+   * reduction tile one rank per grid row gets the A panel of that row and broadcasts it along
+   * the row, one rank per grid column does the same for the B panel, and each rank updates its
+   * local C panel with a single GEMM. Layers take every repl-th reduction tile and their partial
+   * C panels are accumulated into C (2.5D). With a single layer the grid follows the process
+   * grid of C, so every rank accumulates into the blocks it owns.
+   */
+  void execute_summa(ExecutionContext& ec, const IntLabelVec& aouter, const IntLabelVec& bouter,
+                     const IntLabelVec& inner) {
+    auto& oprof = tamm::OpProfiler::instance();
+
+    auto ctensor = lhs_.tensor();
+    auto atensor = rhs1_.tensor();
+    auto btensor = rhs2_.tensor();
+
+    auto pos_in = [](const IntLabelVec& v, IntLabel l) -> int {
+      auto it = std::find(v.begin(), v.end(), l);
+      return it == v.end() ? -1 : static_cast<int>(it - v.begin());
+    };
+    auto positions = [&](const IntLabelVec& grp, const IntLabelVec& v) {
+      std::vector<int> ret;
+      for(const auto l: grp) ret.push_back(pos_in(v, l));
+      return ret;
+    };
+    const std::vector<int> c_apos = positions(aouter, lhs_int_labels_);
+    const std::vector<int> c_bpos = positions(bouter, lhs_int_labels_);
+
+    const TileMatrix                tm          = tile_matrix(aouter, bouter, inner);
+    const IndexLabelVec&            aouter_lbls = tm.aouter_lbls;
+    const IndexLabelVec&            bouter_lbls = tm.bouter_lbls;
+    const IndexLabelVec&            inner_lbls  = tm.inner_lbls;
+    const std::vector<IndexVector>& rows        = tm.rows;
+    const std::vector<IndexVector>& cols        = tm.cols;
+    const std::vector<IndexVector>& ksteps      = tm.ksteps;
+
+    const int nproc = ec.pg().size().value();
+    const int me    = ec.pg().rank().value();
+    const int repl  = std::max(1, std::min(options_.summa_repl, nproc));
+
+    std::vector<int> row_owner(rows.size()), col_owner(cols.size());
+    int              pr = 1, pc = 1, layer = 0, grow = 0, gcol = 0;
+    bool             active = true;
+
+    if(repl == 1) {
+      // align the grid with the process grid of C: grid row/column of a tuple is the
+      // mixed-radix index of (tile % grid) over its dimensions, as in Distribution_Dense
+      const auto       pgrid = ctensor.proc_grid();
+      std::vector<int> cgrid;
+      for(const auto& p: pgrid) cgrid.push_back(static_cast<int>(p.value()));
+      std::vector<int> mycoord(cgrid.size());
+      int              fac = 1;
+      for(size_t d = 0; d < cgrid.size(); d++) {
+        mycoord[d] = (me / fac) % cgrid[d];
+        fac *= cgrid[d];
+      }
+      active = me < fac;
+
+      auto grid_index = [&](const std::vector<int>& cpos, const IndexVector& tiles, int& extent) {
+        int idx = 0;
+        extent  = 1;
+        for(size_t i = 0; i < cpos.size(); i++) {
+          const auto p  = cpos[i];
+          const auto tt = lhs_.labels()[p].tiled_index_space().translate(
+            tiles[i], ctensor.tiled_index_spaces()[p]);
+          idx += static_cast<int>(tt % cgrid[p]) * extent;
+          extent *= cgrid[p];
+        }
+        return idx;
+      };
+      for(size_t r = 0; r < rows.size(); r++) row_owner[r] = grid_index(c_apos, rows[r], pr);
+      for(size_t c = 0; c < cols.size(); c++) col_owner[c] = grid_index(c_bpos, cols[c], pc);
+      for(size_t i = 0; i < c_apos.size(); i++) {
+        int radix = 1;
+        for(size_t j = 0; j < i; j++) radix *= cgrid[c_apos[j]];
+        grow += mycoord[c_apos[i]] * radix;
+      }
+      for(size_t i = 0; i < c_bpos.size(); i++) {
+        int radix = 1;
+        for(size_t j = 0; j < i; j++) radix *= cgrid[c_bpos[j]];
+        gcol += mycoord[c_bpos[i]] * radix;
+      }
+    }
+    else {
+      const int npl          = nproc / repl;
+      int64_t   nrow_indices = 0, ncol_indices = 0;
+      for(const auto& r: rows)
+        nrow_indices += TileMatrix::volume(TileMatrix::tile_dims(aouter_lbls, r));
+      for(const auto& c: cols)
+        ncol_indices += TileMatrix::volume(TileMatrix::tile_dims(bouter_lbls, c));
+      auto grid = internal::compute_proc_grid(2, {nrow_indices, ncol_indices}, npl, 0.0, 0,
+                                              {-1, -1});
+      pr        = static_cast<int>(grid[0]);
+      pc        = static_cast<int>(grid[1]);
+      active    = me < repl * pr * pc;
+      layer     = me / (pr * pc);
+      grow      = (me % (pr * pc)) / pc;
+      gcol      = me % pc;
+      for(size_t r = 0; r < rows.size(); r++) row_owner[r] = static_cast<int>(r % pr);
+      for(size_t c = 0; c < cols.size(); c++) col_owner[c] = static_cast<int>(c % pc);
+    }
+
+    // ranks in a row communicator are ordered by grid column and vice versa
+    MPI_Comm comm = ec.pg().comm();
+    MPI_Comm row_comm, col_comm;
+    MPI_Comm_split(comm, active ? layer * pr + grow : MPI_UNDEFINED, gcol, &row_comm);
+    MPI_Comm_split(comm, active ? layer * pc + gcol : MPI_UNDEFINED, grow, &col_comm);
+    if(!active) return;
+
+    std::vector<size_t>  my_rows, my_cols, row_off, col_off;
+    std::vector<SizeVec> row_dims, col_dims;
+    size_t               Mloc = 0, Nloc = 0;
+    for(size_t r = 0; r < rows.size(); r++) {
+      if(row_owner[r] != grow) continue;
+      my_rows.push_back(r);
+      row_dims.push_back(TileMatrix::tile_dims(aouter_lbls, rows[r]));
+      row_off.push_back(Mloc);
+      Mloc += TileMatrix::volume(row_dims.back());
+    }
+    for(size_t c = 0; c < cols.size(); c++) {
+      if(col_owner[c] != gcol) continue;
+      my_cols.push_back(c);
+      col_dims.push_back(TileMatrix::tile_dims(bouter_lbls, cols[c]));
+      col_off.push_back(Nloc);
+      Nloc += TileMatrix::volume(col_dims.back());
+    }
+
+    IntLabelVec ainter_labels{aouter};
+    ainter_labels.insert(ainter_labels.end(), inner.begin(), inner.end());
+    IntLabelVec binter_labels{inner};
+    binter_labels.insert(binter_labels.end(), bouter.begin(), bouter.end());
+    IntLabelVec cinter_labels{aouter};
+    cinter_labels.insert(cinter_labels.end(), bouter.begin(), bouter.end());
+
+    // the panels are sized once for the widest reduction step of this layer; a step uses the
+    // leading Mloc x K and K x Nloc part of them
+    size_t Kmax = 0;
+    for(size_t t = static_cast<size_t>(layer); t < ksteps.size(); t += repl)
+      Kmax = std::max(Kmax, TileMatrix::volume(TileMatrix::tile_dims(inner_lbls, ksteps[t])));
+    EXPECTS(Mloc * Kmax * sizeof(T) <= static_cast<size_t>(std::numeric_limits<int>::max()) &&
+            Kmax * Nloc * sizeof(T) <= static_cast<size_t>(std::numeric_limits<int>::max()));
+
+    std::vector<T> cpanel(Mloc * Nloc, T{0});
+    std::vector<T> apanel(Mloc * Kmax), bpanel(Kmax * Nloc), buf, tile;
+
+    for(size_t t = static_cast<size_t>(layer); t < ksteps.size(); t += repl) {
+      const SizeVec kdims = TileMatrix::tile_dims(inner_lbls, ksteps[t]);
+      const size_t  K     = TileMatrix::volume(kdims);
+      const int     aroot = static_cast<int>((t / repl) % pc);
+      const int     broot = static_cast<int>((t / repl) % pr);
+
+      // the roots overwrite every block of their panel, zero blocks included
+      if(gcol == aroot) {
+        TimerGuard tg_get{&oprof.multOpGetTime};
+        for(size_t i = 0; i < my_rows.size(); i++) {
+          T* const   adst     = apanel.data() + row_off[i] * K;
+          const auto ablockid = internal::translate_blockid(
+            tm.blockid(rhs1_int_labels_, &rows[my_rows[i]], nullptr, &ksteps[t]), rhs1_);
+          if(!atensor.is_non_zero(ablockid)) {
+            std::fill_n(adst, TileMatrix::volume(row_dims[i]) * K, T{0});
+            continue;
+          }
+          const size_t asize = atensor.block_size(ablockid);
+          buf.resize(asize);
+          atensor.get(ablockid, {buf.data(), asize});
+          SizeVec adims_sz;
+          for(const auto v: atensor.block_dims(ablockid)) adims_sz.push_back(v);
+          SizeVec ainter_dims{row_dims[i]};
+          ainter_dims.insert(ainter_dims.end(), kdims.begin(), kdims.end());
+          kernels::assign<T>(adst, ainter_dims, ainter_labels, T{1}, buf.data(), adims_sz,
+                             rhs1_int_labels_, true);
+        }
+      }
+      {
+        TimerGuard tg_bcast{&oprof.multOpBcastTime};
+        MPI_Bcast(apanel.data(), static_cast<int>(Mloc * K * sizeof(T)), MPI_BYTE, aroot,
+                  row_comm);
+      }
+
+      if(grow == broot) {
+        TimerGuard tg_get{&oprof.multOpGetTime};
+        for(size_t j = 0; j < my_cols.size(); j++) {
+          const size_t Nc       = TileMatrix::volume(col_dims[j]);
+          const auto   bblockid = internal::translate_blockid(
+            tm.blockid(rhs2_int_labels_, nullptr, &cols[my_cols[j]], &ksteps[t]), rhs2_);
+          if(!btensor.is_non_zero(bblockid)) {
+            for(size_t k = 0; k < K; k++)
+              std::fill_n(bpanel.data() + k * Nloc + col_off[j], Nc, T{0});
+            continue;
+          }
+          const size_t bsize = btensor.block_size(bblockid);
+          buf.resize(bsize);
+          btensor.get(bblockid, {buf.data(), bsize});
+          SizeVec bdims_sz;
+          for(const auto v: btensor.block_dims(bblockid)) bdims_sz.push_back(v);
+          SizeVec binter_dims{kdims};
+          binter_dims.insert(binter_dims.end(), col_dims[j].begin(), col_dims[j].end());
+          tile.resize(K * Nc);
+          kernels::assign<T>(tile.data(), binter_dims, binter_labels, T{1}, buf.data(), bdims_sz,
+                             rhs2_int_labels_, true);
+          for(size_t k = 0; k < K; k++) {
+            std::copy(tile.data() + k * Nc, tile.data() + (k + 1) * Nc,
+                      bpanel.data() + k * Nloc + col_off[j]);
+          }
+        }
+      }
+      {
+        TimerGuard tg_bcast{&oprof.multOpBcastTime};
+        MPI_Bcast(bpanel.data(), static_cast<int>(K * Nloc * sizeof(T)), MPI_BYTE, broot,
+                  col_comm);
+      }
+
+      if(Mloc == 0 || Nloc == 0 || K == 0) continue;
+      {
+        TimerGuard tg_dgemm{&oprof.multOpDgemmTime};
+        kernels::cpu::gemm(static_cast<int>(Mloc), static_cast<int>(Nloc), static_cast<int>(K),
+                           alpha_, apanel.data(), static_cast<int>(K), bpanel.data(),
+                           static_cast<int>(Nloc), T{1}, cpanel.data(), static_cast<int>(Nloc));
+      }
+    }
+
+    // scatter the local C panel back into C's blocks
+    for(size_t i = 0; i < my_rows.size(); i++) {
+      for(size_t j = 0; j < my_cols.size(); j++) {
+        const auto cblockid = internal::translate_blockid(
+          tm.blockid(lhs_int_labels_, &rows[my_rows[i]], &cols[my_cols[j]], nullptr), lhs_);
+        if(!ctensor.is_non_zero(cblockid)) continue;
+        const size_t Mr = TileMatrix::volume(row_dims[i]);
+        const size_t Nc = TileMatrix::volume(col_dims[j]);
+        tile.resize(Mr * Nc);
+        for(size_t m = 0; m < Mr; m++) {
+          const T* src = cpanel.data() + (row_off[i] + m) * Nloc + col_off[j];
+          std::copy(src, src + Nc, tile.data() + m * Nc);
+        }
+        SizeVec cinter_dims{row_dims[i]};
+        cinter_dims.insert(cinter_dims.end(), col_dims[j].begin(), col_dims[j].end());
+        SizeVec cdims_sz;
+        for(const auto v: ctensor.block_dims(cblockid)) cdims_sz.push_back(v);
+        const size_t csize = ctensor.block_size(cblockid);
+        buf.resize(csize);
+        kernels::assign<T>(buf.data(), cdims_sz, lhs_int_labels_, T{1}, tile.data(), cinter_dims,
+                           cinter_labels, true);
+        if(epilogue_) {
+          internal::apply_epilogue(epilogue_, buf.data(), ctensor.block_dims(cblockid),
+                                   ctensor.block_offsets(cblockid));
+        }
+        {
+          TimerGuard tg_add{&oprof.multOpAddTime};
+          ctensor.add(cblockid, {buf.data(), csize});
+        }
+      }
+    }
+
+    MPI_Comm_free(&row_comm);
+    MPI_Comm_free(&col_comm);
+  }
+
+  using BlockConsumer =
+    std::function<void(const IndexVector&, span<typename LabeledTensorT1::element_type>)>;
+
+  /**
+   * @brief Panel engine for contractions over a long three-index (Cholesky / density-fitting)
+   * index, e.g. X(a,b,i,j) = L(a,i,Q) * L(b,j,Q).
+   *
+   * The A blocks of all reduction tiles of an output row are assembled once into an
+   * M x K panel and B panels (K x N) are kept in an LRU cache bounded by
+   * TAMM_MULTOP_DF_CACHE_MB, so a three-index block is fetched once per panel rather than
+   * once per output block, and each output block is a single GEMM over the whole reduction.
+   *
+   * Without @p consumer the output blocks are added to C by their owners. With @p consumer
+   * they are distributed round-robin and passed to it instead, so C does not have to be
+   * allocated (see cholesky_contract()).
+   */
+  void execute_df(ExecutionContext& ec, const IntLabelVec& aouter, const IntLabelVec& bouter,
+                  const IntLabelVec& inner, const BlockConsumer& consumer = nullptr) {
+    auto& oprof = tamm::OpProfiler::instance();
+
+    auto ctensor = lhs_.tensor();
+    auto atensor = rhs1_.tensor();
+    auto btensor = rhs2_.tensor();
+
+    const TileMatrix tm = tile_matrix(aouter, bouter, inner);
+
+    std::vector<SizeVec> kdims;
+    std::vector<size_t>  koff;
+    size_t               K = 0;
+    for(const auto& kst: tm.ksteps) {
+      kdims.push_back(TileMatrix::tile_dims(tm.inner_lbls, kst));
+      koff.push_back(K);
+      K += TileMatrix::volume(kdims.back());
+    }
+
+    // Reduction tiles [first, last) whose A panels stay within the panel limit. With more than
+    // one chunk, the C block is accumulated over the chunks and A panels are no longer shared
+    // by the blocks of a row.
+    size_t max_rows = 1;
+    for(const auto& row: tm.rows) {
+      max_rows = std::max(max_rows, TileMatrix::volume(TileMatrix::tile_dims(tm.aouter_lbls, row)));
+    }
+    const size_t                           panel_bytes = options_.df_panel_mb * 1024 * 1024;
+    std::vector<std::pair<size_t, size_t>> kchunks;
+    for(size_t t = 0; t < tm.ksteps.size(); t++) {
+      const size_t width = koff[t] + TileMatrix::volume(kdims[t]);
+      if(kchunks.empty() ||
+         (panel_bytes > 0 && (width - koff[kchunks.back().first]) * max_rows * sizeof(T) >
+                               panel_bytes)) {
+        kchunks.push_back({t, t + 1});
+      }
+      else kchunks.back().second = t + 1;
+    }
+    auto chunk_width = [&](size_t ch) {
+      const auto [first, last] = kchunks[ch];
+      return koff[last - 1] + TileMatrix::volume(kdims[last - 1]) - koff[first];
+    };
+
+    // output blocks of this rank in row-major (row, col) order, so that A panels are reused
+    const Proc                             me    = ec.pg().rank();
+    const size_t                           nproc = ec.pg().size().value();
+    std::vector<std::pair<size_t, size_t>> my_blocks;
+    size_t                                 counter = 0;
+    for(size_t r = 0; r < tm.rows.size(); r++) {
+      for(size_t c = 0; c < tm.cols.size(); c++) {
+        const auto cblockid = internal::translate_blockid(
+          tm.blockid(lhs_int_labels_, &tm.rows[r], &tm.cols[c], nullptr), lhs_);
+        if(!ctensor.is_non_zero(cblockid)) continue;
+        const bool mine = consumer ? (counter++ % nproc == static_cast<size_t>(me.value()))
+                                   : std::get<0>(ctensor.distribution().locate(cblockid)) == me;
+        if(mine) my_blocks.push_back({r, c});
+      }
+    }
+    if(my_blocks.empty()) return;
+
+    IntLabelVec ainter_labels{aouter};
+    ainter_labels.insert(ainter_labels.end(), inner.begin(), inner.end());
+    IntLabelVec binter_labels{inner};
+    binter_labels.insert(binter_labels.end(), bouter.begin(), bouter.end());
+    IntLabelVec cinter_labels{aouter};
+    cinter_labels.insert(cinter_labels.end(), bouter.begin(), bouter.end());
+
+    std::vector<T> apanel, buf, tile, cinter, cbuf;
+
+    // A panel of row r over chunk ch: [aouter, inner] with the reduction tiles side by side
+    auto fetch_a_panel = [&](size_t r, size_t ch, const SizeVec& rdims, size_t M) {
+      const size_t Kc = chunk_width(ch);
+      apanel.assign(M * Kc, T{0});
+      for(size_t t = kchunks[ch].first; t < kchunks[ch].second; t++) {
+        const auto ablockid = internal::translate_blockid(
+          tm.blockid(rhs1_int_labels_, &tm.rows[r], nullptr, &tm.ksteps[t]), rhs1_);
+        if(!atensor.is_non_zero(ablockid)) continue;
+        const size_t asize = atensor.block_size(ablockid);
+        buf.resize(asize);
+        atensor.get(ablockid, {buf.data(), asize});
+        SizeVec adims_sz;
+        for(const auto v: atensor.block_dims(ablockid)) adims_sz.push_back(v);
+        SizeVec ainter_dims{rdims};
+        ainter_dims.insert(ainter_dims.end(), kdims[t].begin(), kdims[t].end());
+        const size_t Kt = TileMatrix::volume(kdims[t]);
+        tile.resize(M * Kt);
+        kernels::assign<T>(tile.data(), ainter_dims, ainter_labels, T{1}, buf.data(), adims_sz,
+                           rhs1_int_labels_, true);
+        const size_t kpos = koff[t] - koff[kchunks[ch].first];
+        for(size_t m = 0; m < M; m++) {
+          std::copy(tile.data() + m * Kt, tile.data() + (m + 1) * Kt,
+                    apanel.data() + m * Kc + kpos);
+        }
+      }
+    };
+
+    // B panel of column c over chunk ch: [inner, bouter] with the reduction tiles stacked
+    auto fetch_b_panel = [&](size_t c, size_t ch, const SizeVec& cdims, size_t N,
+                             std::vector<T>& bpanel) {
+      bpanel.assign(chunk_width(ch) * N, T{0});
+      for(size_t t = kchunks[ch].first; t < kchunks[ch].second; t++) {
+        const auto bblockid = internal::translate_blockid(
+          tm.blockid(rhs2_int_labels_, nullptr, &tm.cols[c], &tm.ksteps[t]), rhs2_);
+        if(!btensor.is_non_zero(bblockid)) continue;
+        const size_t bsize = btensor.block_size(bblockid);
+        buf.resize(bsize);
+        btensor.get(bblockid, {buf.data(), bsize});
+        SizeVec bdims_sz;
+        for(const auto v: btensor.block_dims(bblockid)) bdims_sz.push_back(v);
+        SizeVec binter_dims{kdims[t]};
+        binter_dims.insert(binter_dims.end(), cdims.begin(), cdims.end());
+        const size_t kpos = koff[t] - koff[kchunks[ch].first];
+        kernels::assign<T>(bpanel.data() + kpos * N, binter_dims, binter_labels, T{1},
+                           buf.data(), bdims_sz, rhs2_int_labels_, true);
+      }
+    };
+
+    size_t max_kchunk = 1, max_bpanel = 1;
+    for(size_t ch = 0; ch < kchunks.size(); ch++) {
+      max_kchunk = std::max(max_kchunk, chunk_width(ch));
+    }
+    for(const auto& col: tm.cols) {
+      max_bpanel = std::max(max_bpanel, max_kchunk * TileMatrix::volume(TileMatrix::tile_dims(
+                                                       tm.bouter_lbls, col)));
+    }
+    const size_t cache_bytes = options_.df_cache_mb * 1024 * 1024;
+    const auto   cache_size =
+      static_cast<uint32_t>(std::max<size_t>(1, cache_bytes / (max_bpanel * sizeof(T))));
+    LRUCache<Index, std::vector<T>> bcache{cache_size};
+    bcache.reset_clock();
+
+    size_t arow = tm.rows.size(), achunk = kchunks.size();
+    for(const auto& [r, c]: my_blocks) {
+      const SizeVec rdims = TileMatrix::tile_dims(tm.aouter_lbls, tm.rows[r]);
+      const SizeVec cdims = TileMatrix::tile_dims(tm.bouter_lbls, tm.cols[c]);
+      const size_t  M     = TileMatrix::volume(rdims);
+      const size_t  N     = TileMatrix::volume(cdims);
+
+      cinter.assign(M * N, T{0});
+      for(size_t ch = 0; ch < kchunks.size(); ch++) {
+        {
+          TimerGuard tg_get{&oprof.multOpGetTime};
+          if(r != arow || ch != achunk) {
+            fetch_a_panel(r, ch, rdims, M);
+            arow   = r;
+            achunk = ch;
+          }
+        }
+        // panels are cached per column and chunk
+        IndexVector bkey{tm.cols[c]};
+        bkey.push_back(static_cast<Index>(ch));
+        auto [hit, bpanel] = bcache.log_access(bkey);
+        if(!hit) {
+          TimerGuard tg_get{&oprof.multOpGetTime};
+          fetch_b_panel(c, ch, cdims, N, bpanel);
+        }
+
+        const size_t Kc = chunk_width(ch);
+        if(M > 0 && N > 0 && Kc > 0) {
+          TimerGuard tg_dgemm{&oprof.multOpDgemmTime};
+          kernels::cpu::gemm(static_cast<int>(M), static_cast<int>(N), static_cast<int>(Kc),
+                             alpha_, apanel.data(), static_cast<int>(Kc), bpanel.data(),
+                             static_cast<int>(N), ch == 0 ? T{0} : T{1}, cinter.data(),
+                             static_cast<int>(N));
+        }
+      }
+
+      const auto cblockid = internal::translate_blockid(
+        tm.blockid(lhs_int_labels_, &tm.rows[r], &tm.cols[c], nullptr), lhs_);
+      SizeVec cdims_sz;
+      for(const auto v: ctensor.block_dims(cblockid)) cdims_sz.push_back(v);
+      const size_t csize = ctensor.block_size(cblockid);
+      SizeVec      cinter_dims{rdims};
+      cinter_dims.insert(cinter_dims.end(), cdims.begin(), cdims.end());
+      cbuf.resize(csize);
+      kernels::assign<T>(cbuf.data(), cdims_sz, lhs_int_labels_, T{1}, cinter.data(), cinter_dims,
+                         cinter_labels, true);
+      if(epilogue_) {
+        internal::apply_epilogue(epilogue_, cbuf.data(), ctensor.block_dims(cblockid),
+                                 ctensor.block_offsets(cblockid));
+      }
+      if(consumer) consumer(cblockid, {cbuf.data(), csize});
+      else {
+        TimerGuard tg_add{&oprof.multOpAddTime};
+        ctensor.add(cblockid, {cbuf.data(), csize});
+      }
+    }
+  }
+
+  /// execute_df() for a plain contraction, passing every output block to @p consumer
+  void execute_df(ExecutionContext& ec, const BlockConsumer& consumer) {
+    IntLabelVec aouter, bouter, inner;
+    EXPECTS(matrix_label_groups(aouter, bouter, inner));
+    execute_df(ec, aouter, bouter, inner, consumer);
+  }
+
 #if 0
     TensorBase* writes() const { return plan_obj_->writes(*this); }
 
@@ -956,6 +1995,128 @@ protected:
     fillin_tensor_label_from_map(rhs2_, str_to_labels);
   }
 
+  /// Zero C on every rank before the products of an assign are accumulated into it. Collective.
+  void zero_lhs(ExecutionContext& ec) {
+    lhs_.tensor().base_ptr()->zero_local_buf();
+    ec.pg().barrier();
+  }
+
+  /**
+   * @brief Split the labels of a plain contraction C[aouter,bouter] += A[aouter,inner] *
+   * B[inner,bouter] into its three groups. aouter and bouter follow the order in C, inner
+   * follows the order in A.
+   *
+   * @return false if the operation is not a plain contraction, i.e. it has batch
+   * (Hadamard) labels, labels reduced within a single operand, repeated labels or no
+   * reduction labels.
+   */
+  bool matrix_label_groups(IntLabelVec& aouter, IntLabelVec& bouter, IntLabelVec& inner) const {
+    aouter.clear();
+    bouter.clear();
+    inner.clear();
+    if(internal::unique_entries(lhs_int_labels_).size() != lhs_int_labels_.size() ||
+       internal::unique_entries(rhs1_int_labels_).size() != rhs1_int_labels_.size() ||
+       internal::unique_entries(rhs2_int_labels_).size() != rhs2_int_labels_.size()) {
+      return false;
+    }
+    auto has = [](const IntLabelVec& v, IntLabel l) {
+      return std::find(v.begin(), v.end(), l) != v.end();
+    };
+    for(const auto l: lhs_int_labels_) {
+      if(has(rhs1_int_labels_, l) == has(rhs2_int_labels_, l)) return false;
+      if(has(rhs1_int_labels_, l)) aouter.push_back(l);
+      else bouter.push_back(l);
+    }
+    for(const auto l: rhs1_int_labels_) {
+      if(has(lhs_int_labels_, l)) continue;
+      if(!has(rhs2_int_labels_, l)) return false;
+      inner.push_back(l);
+    }
+    for(const auto l: rhs2_int_labels_) {
+      if(!has(lhs_int_labels_, l) && !has(rhs1_int_labels_, l)) return false;
+    }
+    return !inner.empty();
+  }
+
+  /**
+   * @brief A plain contraction viewed as a matrix product over tile tuples: rows are the
+   * tile tuples of the aouter labels, columns those of the bouter labels and reduction steps
+   * those of the inner labels (see matrix_label_groups()).
+   */
+  struct TileMatrix {
+    TileMatrix(IntLabelVec aouter_labels, IntLabelVec bouter_labels, IntLabelVec inner_labels):
+      aouter{std::move(aouter_labels)},
+      bouter{std::move(bouter_labels)},
+      inner{std::move(inner_labels)} {}
+
+    IntLabelVec              aouter, bouter, inner;
+    IndexLabelVec            aouter_lbls, bouter_lbls, inner_lbls;
+    std::vector<IndexVector> rows, cols, ksteps;
+
+    static SizeVec tile_dims(const IndexLabelVec& lbls, const IndexVector& tiles) {
+      SizeVec ret;
+      for(size_t i = 0; i < lbls.size(); i++) {
+        ret.push_back(lbls[i].tiled_index_space().tile_size(tiles[i]));
+      }
+      return ret;
+    }
+
+    static size_t volume(const SizeVec& dims) {
+      size_t n = 1;
+      for(const auto d: dims) n *= d.value();
+      return n;
+    }
+
+    /// Block id over @p ilbls assembled from a row, column and/or reduction step tuple
+    IndexVector blockid(const IntLabelVec& ilbls, const IndexVector* row, const IndexVector* col,
+                        const IndexVector* kst) const {
+      auto pos_in = [](const IntLabelVec& v, IntLabel l) -> int {
+        auto it = std::find(v.begin(), v.end(), l);
+        return it == v.end() ? -1 : static_cast<int>(it - v.begin());
+      };
+      IndexVector ret(ilbls.size());
+      for(size_t i = 0; i < ilbls.size(); i++) {
+        int p;
+        if(row && (p = pos_in(aouter, ilbls[i])) >= 0) ret[i] = (*row)[p];
+        else if(col && (p = pos_in(bouter, ilbls[i])) >= 0) ret[i] = (*col)[p];
+        else ret[i] = (*kst)[pos_in(inner, ilbls[i])];
+      }
+      return ret;
+    }
+  };
+
+  TileMatrix tile_matrix(const IntLabelVec& aouter, const IntLabelVec& bouter,
+                         const IntLabelVec& inner) const {
+    TileMatrix tm{aouter, bouter, inner};
+    auto       group = [](const IntLabelVec& grp, const IntLabelVec& ilbls,
+                          const IndexLabelVec& lbls) {
+      IndexLabelVec ret;
+      for(const auto l: grp) {
+        ret.push_back(lbls[std::find(ilbls.begin(), ilbls.end(), l) - ilbls.begin()]);
+      }
+      return ret;
+    };
+    tm.aouter_lbls = group(aouter, lhs_int_labels_, lhs_.labels());
+    tm.bouter_lbls = group(bouter, lhs_int_labels_, lhs_.labels());
+    tm.inner_lbls  = group(inner, rhs1_int_labels_, rhs1_.labels());
+
+    // tile tuples of a label group; an empty group has a single empty tuple
+    auto tuples = [](const IndexLabelVec& lbls) {
+      std::vector<IndexVector> ret;
+      if(lbls.empty()) {
+        ret.push_back(IndexVector{});
+        return ret;
+      }
+      LabelLoopNest nest{lbls};
+      for(const auto& it: nest) ret.push_back(it);
+      return ret;
+    };
+    tm.rows   = tuples(tm.aouter_lbls);
+    tm.cols   = tuples(tm.bouter_lbls);
+    tm.ksteps = tuples(tm.inner_lbls);
+    return tm;
+  }
+
   void fillin_int_labels() {
     std::map<TileLabelElement, int> primary_labels_map;
     int                             cnt = -1;
@@ -1033,6 +2194,9 @@ protected:
   IntLabelVec     rhs2_int_labels_;
   bool            is_assign_;
 
+  ElementEpilogue<typename LabeledTensorT1::element_type> epilogue_;
+  MultOpOptions                                           options_;
+
 public:
   std::string opstr_;
 
@@ -1045,6 +2209,22 @@ public:
 
 }; // class MultOp
 
+/**
+ * @brief Compute X = alpha * L1 * L2 over a long three-index (Cholesky / density-fitting)
+ * index with the panel engine of MultOp::execute_df and pass each X block (block id of X,
+ * data in X's layout) to @p consumer instead of storing it. This fuses terms like
+ * X(a,b,i,j) = L(a,i,Q) * L(b,j,Q) into the contraction that consumes X without forming the
+ * four-index intermediate; X only describes the output and need not be allocated.
+ * Collective over @p ec.
+ */
+template<typename T>
+void cholesky_contract(ExecutionContext& ec, LabeledTensor<T> X, T alpha, LabeledTensor<T> L1,
+                       LabeledTensor<T> L2,
+                       std::function<void(const IndexVector&, span<T>)> consumer) {
+  MultOp<T, LabeledTensor<T>, LabeledTensor<T>, LabeledTensor<T>> mop{X, alpha, L1, L2, false};
+  mop.execute_df(ec, consumer);
+}
+
 } // namespace tamm
 
 namespace tamm::internal {
@@ -1073,20 +2253,23 @@ void FlatMultPlan<T, LabeledTensorT1, LabeledTensorT2, LabeledTensorT3>::apply(
   size_t              lhs_size = lhs_lt.tensor().local_buf_size();
   std::vector<size_t> lhs_dims{lhs_size};
 
-  T2*                 rhs1_buf  = rhs1_lt.tensor().access_local_buf();
-  size_t              rhs1_size = rhs1_lt.tensor().local_buf_size();
+  // the operands are read through their const buffers, which keeps their cached block norms
+  const Tensor<T2>    rhs1_tensor = rhs1_lt.tensor();
+  const T2*           rhs1_buf    = rhs1_tensor.access_local_buf();
+  size_t              rhs1_size   = rhs1_tensor.local_buf_size();
   std::vector<size_t> rhs1_dims{rhs1_size};
 
-  T3*                 rhs2_buf  = rhs2_lt.tensor().access_local_buf();
-  size_t              rhs2_size = rhs2_lt.tensor().local_buf_size();
+  const Tensor<T3>    rhs2_tensor = rhs2_lt.tensor();
+  const T3*           rhs2_buf    = rhs2_tensor.access_local_buf();
+  size_t              rhs2_size   = rhs2_tensor.local_buf_size();
   std::vector<size_t> rhs2_dims{rhs2_size};
 
   EXPECTS(rhs1_size == lhs_size);
   EXPECTS(rhs2_size == lhs_size);
 
   BlockSpan<T1> lhs_span{lhs_buf, lhs_dims};
-  BlockSpan<T2> rhs1_span{rhs1_buf, rhs1_dims};
-  BlockSpan<T3> rhs2_span{rhs2_buf, rhs2_dims};
+  BlockSpan<T2> rhs1_span{const_cast<T2*>(rhs1_buf), rhs1_dims};
+  BlockSpan<T3> rhs2_span{const_cast<T3*>(rhs2_buf), rhs2_dims};
 
   BlockMultPlan::OpType optype = is_assign ? BlockMultPlan::OpType::set
                                            : BlockMultPlan::OpType::update;
@@ -23,6 +23,13 @@ public:
   virtual void   execute(ExecutionContext& ec, ExecutionHW hw = ExecutionHW::CPU) = 0;
   virtual OpList canonicalize() const                                             = 0;
   virtual OpType op_type() const                                                  = 0;
+  /// Op doing this op and then @p next at once, or nullptr if the two cannot be fused
+  virtual std::shared_ptr<Op> fuse(const Op& next) const { return nullptr; }
+  /// Tensor this op fills with zeros as a whole, or nullptr
+  virtual TensorBase* zero_fills() const { return nullptr; }
+  /// Op with the result of this op when its output is zero on entry and that sets every block of
+  /// the output without reading it, or nullptr if there is none
+  virtual std::shared_ptr<Op> first_write_form() const { return nullptr; }
   virtual ~Op() {}
   std::string opstr_;
   ExecutionHW exhw_ = ExecutionHW::DEFAULT;
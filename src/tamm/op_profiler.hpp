@@ -25,6 +25,18 @@ public:
   double multOpWaitTime  = 0;
   double multOpCopyTime  = 0;
   double multOpDgemmTime = 0;
+  // panel broadcasts of the SUMMA engine (TAMM_MULTOP_SUMMA), accumulated on this rank; the
+  // block gets that fill the panels are counted in multOpGetTime
+  double multOpBcastTime = 0;
+
+  // norm-based screening (TAMM_MULTOP_SCREEN_THRESH): flops of the block products considered
+  // and of those skipped, accumulated on this rank
+  double multOpTotalFlops    = 0;
+  double multOpScreenedFlops = 0;
+
+  double screened_flop_fraction() const {
+    return multOpTotalFlops > 0 ? multOpScreenedFlops / multOpTotalFlops : 0.0;
+  }
 
   inline static OpProfiler& instance() {
     static OpProfiler op_prof;
@@ -2,7 +2,9 @@
 
 #include "tamm/addop.hpp"
 #include "tamm/allocop.hpp"
+#include "tamm/copyop.hpp"
 #include "tamm/deallocop.hpp"
+#include "tamm/ewise_expr.hpp"
 #include "tamm/mapop.hpp"
 #include "tamm/multop.hpp"
 #include "tamm/op_base.hpp"
@@ -118,6 +120,12 @@ constexpr auto LabeledTensor<T>::make_op(T1&& rhs, const bool is_assign, const i
                          (is_same_v<rhs1_t, LTT> &&
                           (is_same_v<rhs0_t, LTT_cfloat> || is_same_v<rhs0_t, LTT_cdouble>) )))
         return MultOp<T, LTT, rhs0_t, rhs1_t>{*this, sub_v, get<0>(rhs), get<1>(rhs), is_assign};
+      // LHS is double, rhs1,rhs2 are float/double (mixed precision)
+      else if constexpr(is_same_v<T, double> &&
+                        (is_same_v<rhs0_t, LTT> || is_same_v<rhs0_t, LTT_float>) &&
+                        (is_same_v<rhs1_t, LTT> || is_same_v<rhs1_t, LTT_float>) )
+        return MultOp<T, LTT, rhs0_t, rhs1_t>{*this, static_cast<T>(sub_v), get<0>(rhs),
+                                              get<1>(rhs), is_assign};
     }
 
     // LT = alpha * LT * LT
@@ -155,6 +163,12 @@ constexpr auto LabeledTensor<T>::make_op(T1&& rhs, const bool is_assign, const i
                           (is_same_v<rhs1_t, LTT_cfloat> || is_same_v<rhs1_t, LTT_cdouble>) )))
         return MultOp<T, LTT, rhs1_t, rhs2_t>{*this, static_cast<rhs0_t>(sub_v * get<0>(rhs)),
                                               get<1>(rhs), get<2>(rhs), is_assign};
+      // LHS is double, rhs1,rhs2 are float/double (mixed precision)
+      else if constexpr(is_same_v<T, double> &&
+                        (is_same_v<rhs1_t, LTT> || is_same_v<rhs1_t, LTT_float>) &&
+                        (is_same_v<rhs2_t, LTT> || is_same_v<rhs2_t, LTT_float>) )
+        return MultOp<T, LTT, rhs1_t, rhs2_t>{*this, static_cast<T>(sub_v * get<0>(rhs)),
+                                              get<1>(rhs), get<2>(rhs), is_assign};
       // static_assert(
       //   (is_convertible_v<rhs0_t, T>)&&is_same_v<rhs1_t, LTT> &&
       //     is_same_v<rhs2_t, LTT>,
@@ -2,10 +2,13 @@
 
 #include <map>
 #include <memory>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "tamm/boundvec.hpp"
 #include "tamm/errors.hpp"
+#include "tamm/label_translator.hpp"
 #include "tamm/labeled_tensor.hpp"
 #include "tamm/runtime_engine.hpp"
 #include "tamm/tensor.hpp"
@@ -14,6 +17,15 @@
 #include "tamm/work.hpp"
 
 namespace tamm {
+/**
+ * @ingroup operations
+ * @brief Scan operation. Invoke a function on each block of a tensor to read it.
+ *
+ * When the tensor is distributed over the executing process group, every rank scans the blocks
+ * it owns directly in its local buffer. A functor taking a `span<const T>` then reads the block
+ * in place; one taking a `std::vector<T>&` gets a local copy of it. Otherwise blocks are fetched
+ * with get.
+ */
 template<typename LabeledTensorT, typename Func>
 class ScanOp: public Op {
 public:
@@ -29,8 +41,15 @@ public:
 
   void execute(ExecutionContext& ec, ExecutionHW hw = ExecutionHW::CPU) override {
     using TensorElType = typename LabeledTensorT::element_type;
+    const auto& tensor = lhs_.tensor();
+    const auto  kind   = tensor.kind();
+    if(kind != TensorBase::TensorKind::view && kind != TensorBase::TensorKind::unit_view &&
+       kind != TensorBase::TensorKind::lambda && tensor.execution_context()->pg() == ec.pg()) {
+      execute_local(ec);
+      return;
+    }
+
     // the iterator to generate the tasks
-    const auto&   tensor = lhs_.tensor();
     LabelLoopNest loop_nest{lhs_.labels()};
     // const IndexLabelVec& iter_labels =
     // internal::sort_on_dependence(lhs_.labels());
@@ -54,7 +73,6 @@ public:
       func_(tensor, translated_blockid, buf);
     };
     // ec->...(loop_nest, lambda);
-    //@todo use a scheduler
     do_work(ec, loop_nest, lambda);
   }
 
@@ -67,6 +85,38 @@ public:
   bool is_memory_barrier() const { return false; }
 
 protected:
+  /// Owner-computes execution: each rank scans only its own blocks, without any get
+  void execute_local(ExecutionContext& ec) {
+    using TensorElType = typename LabeledTensorT::element_type;
+
+    auto                      tensor    = lhs_.tensor();
+    const auto&               dist      = tensor.distribution();
+    const Proc                me        = ec.pg().rank();
+    const TensorElType*       local_buf = std::as_const(tensor).access_local_buf();
+    std::vector<TensorElType> buf;
+
+    internal::LabelTranslator translator{lhs_.labels(), tensor().labels()};
+    LabelLoopNest             loop_nest{lhs_.labels()};
+    for(const auto& blockid: loop_nest) {
+      auto [translated_blockid, tlb_valid] = translator.apply(blockid);
+      if(!tlb_valid || !tensor.is_non_zero(translated_blockid)) { continue; }
+
+      auto [proc, offset] = dist.locate(translated_blockid);
+      if(proc != me) { continue; }
+
+      const size_t        size  = tensor.block_size(translated_blockid);
+      const TensorElType* block = local_buf + offset.value();
+      if constexpr(std::is_invocable_v<Func&, Tensor<TensorElType>&, const IndexVector&,
+                                       span<const TensorElType>>) {
+        func_(tensor, translated_blockid, span<const TensorElType>{block, size});
+      }
+      else {
+        buf.assign(block, block + size);
+        func_(tensor, translated_blockid, buf);
+      }
+    }
+  }
+
   void fillin_labels() {
     using internal::fillin_tensor_label_from_map;
     using internal::update_fillin_map;
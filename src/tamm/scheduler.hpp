@@ -11,6 +11,28 @@
 
 namespace tamm {
 
+namespace detail {
+// TAMM_FUSE_ADD_OPS = 1(default, enabled)
+// Merge consecutive accumulates into the same LHS tensor into a single FusedAddOp.
+static const bool tamm_fuse_add_ops = [] {
+  bool fuse_add_ops = true;
+  if(const char* tammFuseAddOps = std::getenv("TAMM_FUSE_ADD_OPS")) {
+    fuse_add_ops = std::atoi(tammFuseAddOps) > 0;
+  }
+  return fuse_add_ops;
+}();
+
+// TAMM_LAZY_ZERO = 1(default, enabled)
+// Defer whole-tensor zero fills until the tensor is first used (Scheduler::resolve_lazy_zero()).
+static const bool tamm_lazy_zero = [] {
+  bool lazy_zero = true;
+  if(const char* tammLazyZero = std::getenv("TAMM_LAZY_ZERO")) {
+    lazy_zero = std::atoi(tammLazyZero) > 0;
+  }
+  return lazy_zero;
+}();
+} // namespace detail
+
 using internal::DAGImpl;
 
 /**
@@ -45,6 +67,13 @@ public:
     for(auto& op: t_ops) {
       op->opstr_ = opstr;
       op->exhw_  = exhw;
+      // ops already executed are never fused with new ones
+      if(detail::tamm_fuse_add_ops && ops_.size() > start_idx_) {
+        if(auto fused = ops_.back()->fuse(*op); fused != nullptr) {
+          ops_.back() = fused;
+          continue;
+        }
+      }
       ops_.push_back(op);
     }
     return (*this);
@@ -203,6 +232,9 @@ public:
 #elif 1
     auto misc_start = std::chrono::high_resolution_clock::now();
     auto order      = levelize_and_order(ops_, start_idx_, ops_.size());
+    // block kernels of the ops use the thread count of this context
+    const int prev_kernel_threads = internal::kernel_threads();
+    internal::kernel_threads()    = ec().kernel_threads();
     EXPECTS(order.size() == ops_.size() - start_idx_);
     size_t         lvl = 0;
     AtomicCounter* ac  = new AtomicCounterGA(ec().pg(), order.size());
@@ -225,6 +257,8 @@ public:
     std::vector<double> multop_add_times;
     std::vector<double> multop_copy_times;
     int                 nops = order.size();
+    // tensors whose zero fill is deferred
+    std::vector<TensorBase*> lazy_zero_tensors;
 
     assert(order.size() == 0 || order[0].first == 0); // level 0 sanity check
     for(size_t i = 0; i < order.size(); i++) {
@@ -248,8 +282,14 @@ public:
       ec().set_ac(IndexedAC(ac, i));
       if(ops_[order[i].second]->exhw_ != ExecutionHW::DEFAULT)
         execute_on = ops_[order[i].second]->exhw_;
+      auto op = ops_[order[i].second];
+      if(detail::tamm_lazy_zero) op = resolve_lazy_zero(op, lazy_zero_tensors);
       auto t2 = std::chrono::high_resolution_clock::now();
-      ops_[order[i].second]->execute(ec(), execute_on);
+      if(op != nullptr) op->execute(ec(), execute_on);
+      // not every rank writes blocks of the output, so mark its block norms stale on all of them
+      if(auto wr = ops_[order[i].second]->writes(); wr != nullptr) wr->invalidate_block_norms();
+      if(auto acc = ops_[order[i].second]->accumulates(); acc != nullptr)
+        acc->invalidate_block_norms();
       auto t3 = std::chrono::high_resolution_clock::now();
       op_times.push_back(
         std::chrono::duration_cast<std::chrono::duration<double>>((t3 - t2)).count());
@@ -262,6 +302,10 @@ public:
       oprof.multOpAddTime   = 0;
       oprof.multOpCopyTime  = 0;
     }
+    // zeros not written by any op are written now, before the tensors leave the scheduler
+    for(auto* tensor: lazy_zero_tensors) {
+      if(tensor->is_lazy_zero()) zero_lazy_tensor(tensor);
+    }
     auto t2 = std::chrono::high_resolution_clock::now();
     ec().pg().barrier();
     lvl += 1;
@@ -277,7 +321,8 @@ public:
     // oprof.multOpAddTime = 0;
     start_idx_ = ops_.size();
     ec().set_ac(IndexedAC(nullptr, 0));
-    misc_start = t3;
+    internal::kernel_threads() = prev_kernel_threads;
+    misc_start                 = t3;
     ac->deallocate();
     delete ac;
     misc_end = std::chrono::high_resolution_clock::now();
@@ -460,16 +505,7 @@ public:
 
   template<typename T>
   Scheduler& exact_copy(LabeledTensor<T> lhs, LabeledTensor<T> rhs) {
-    auto copy_buf = [](const Tensor<T>& t, const IndexVector& lhs_iv, std::vector<T>& lhs_buf,
-                       const IndexVector rhs_iv[], std::vector<T> rhs_buf[]) {
-      std::copy(rhs_buf[0].begin(), rhs_buf[0].end(), lhs_buf.begin());
-    };
-
-    auto rhs_arr = std::array<LabeledTensor<T>, 1>{rhs};
-
-    ops_.push_back(std::make_shared<MapOp<LabeledTensor<T>, decltype(copy_buf), 1>>(
-      lhs, copy_buf, rhs_arr, ResultMode::set, false));
-
+    ops_.push_back(std::make_shared<CopyOp<LabeledTensor<T>>>(lhs, rhs));
     return *this;
   }
 
@@ -521,6 +557,64 @@ public:
   // }
 
 private:
+  void zero_lazy_tensor(TensorBase* tensor) {
+    tensor->zero_local_buf();
+    tensor->set_lazy_zero(false);
+  }
+
+  /**
+   * @brief Op to execute in place of @p op, or nullptr if there is nothing to execute.
+   *
+   * A zero fill of a whole tensor distributed over the process group of the scheduler is
+   * deferred: the tensor is only marked zero and added to @p lazy_zero_tensors. The first op that
+   * writes or accumulates into it is replaced by its first write form when it has one (e.g.
+   * `X() += Y()` runs as `X() = Y()`), so the zeros are never written. Otherwise, and before an op
+   * reads the tensor, every rank zeroes its local buffer. Views share the memory of their
+   * reference tensor, so they are resolved through it and are never deferred themselves.
+   */
+  std::shared_ptr<Op> resolve_lazy_zero(std::shared_ptr<Op>       op,
+                                        std::vector<TensorBase*>& lazy_zero_tensors) {
+    if(auto* tensor = op->zero_fills(); tensor != nullptr && tensor->memory_owner() == tensor &&
+                                        tensor->execution_context() != nullptr &&
+                                        tensor->execution_context()->pg() == ec().pg()) {
+      tensor->set_lazy_zero(true);
+      if(std::find(lazy_zero_tensors.begin(), lazy_zero_tensors.end(), tensor) ==
+         lazy_zero_tensors.end()) {
+        lazy_zero_tensors.push_back(tensor);
+      }
+      return nullptr;
+    }
+
+    if(op->op_type() == OpType::dealloc) {
+      op->writes()->set_lazy_zero(false);
+      return op;
+    }
+
+    bool zeroed = false;
+    for(auto* tensor: op->reads()) {
+      if(tensor != nullptr && tensor->memory_owner()->is_lazy_zero()) {
+        zero_lazy_tensor(tensor->memory_owner());
+        zeroed = true;
+      }
+    }
+    auto* out = op->writes() != nullptr ? op->writes() : op->accumulates();
+    if(out != nullptr && out->memory_owner()->is_lazy_zero()) {
+      // a write through a view only covers part of the reference tensor
+      auto first_write = out->memory_owner() == out ? op->first_write_form() : nullptr;
+      if(first_write != nullptr) {
+        out->set_lazy_zero(false);
+        op = first_write;
+      }
+      else {
+        zero_lazy_tensor(out->memory_owner());
+        zeroed = true;
+      }
+    }
+    // other ranks may write into or read from the zeroed buffers
+    if(zeroed) ec().pg().barrier();
+    return op;
+  }
+
   ExecutionContext& ec_;
   // void validate() {
   //     // 1. every tensor used by operarions should be listed in tensors_
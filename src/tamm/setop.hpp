@@ -176,6 +176,19 @@ public:
     return std::shared_ptr<Op>(new SetOp<T, LabeledTensorT>{*this});
   }
 
+  /// The whole LHS is assigned zero, which the scheduler may defer
+  TensorBase* zero_fills() const override {
+    if(is_assign_ && alpha_ == T{0} && writes_whole_lhs()) return lhs_.base_ptr();
+    return nullptr;
+  }
+
+  std::shared_ptr<Op> first_write_form() const override {
+    if(!writes_whole_lhs()) return nullptr;
+    auto op        = std::make_shared<SetOp<T, LabeledTensorT>>(*this);
+    op->is_assign_ = true;
+    return op;
+  }
+
   OpType op_type() const override { return OpType::set; }
   void   execute(ExecutionContext& ec, ExecutionHW hw = ExecutionHW::CPU) override {
     EXPECTS(plan_ != Plan::invalid);
@@ -210,6 +223,15 @@ public:
   bool is_memory_barrier() const { return false; }
 
 protected:
+  /// Check if the op sets every block of the LHS tensor, in its own buffer
+  bool writes_whole_lhs() const {
+    using TensorKind = TensorBase::TensorKind;
+
+    const auto kind = lhs_.tensor().kind();
+    return plan_ == Plan::flat && kind != TensorKind::dense && kind != TensorKind::lambda &&
+           kind != TensorKind::unit_view;
+  }
+
   void fillin_labels() {
     using internal::fillin_tensor_label_from_map;
     using internal::update_fillin_map;
@@ -55,6 +55,16 @@ void initialize(int argc, char* argv[], bool is_mpi_tm) {
 }
 
 void finalize(bool tamm_mpi_finalize) {
+  // persist the kernel autotuning decisions once, from rank 0
+  if(!detail::tamm_kernel_tune_file.empty()) {
+#if defined(USE_UPCXX)
+    const bool root = upcxx::rank_me() == 0;
+#else
+    const bool root = GA_Initialized() && GA_Nodeid() == 0;
+#endif
+    if(root) kernels::MultKernelTuner::instance().save(detail::tamm_kernel_tune_file);
+  }
+
 #if defined(USE_UPCXX)
   upcxx::finalize();
 #else
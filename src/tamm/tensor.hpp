@@ -267,10 +267,14 @@ public:
   // Tensor Accessors
 #ifdef USE_UPCXX
   void put_raw_contig(int64_t* lo, int64_t* hi, void* buf) {
+    impl_->invalidate_block_norms();
     return impl_->put_raw_contig(lo, hi, buf);
   }
 
-  void put_raw(int64_t* lo, int64_t* hi, void* buf) { return impl_->put_raw(lo, hi, buf); }
+  void put_raw(int64_t* lo, int64_t* hi, void* buf) {
+    impl_->invalidate_block_norms();
+    return impl_->put_raw(lo, hi, buf);
+  }
 
   void get_raw_contig(int64_t* lo, int64_t* hi, void* buf) {
     return impl_->get_raw_contig(lo, hi, buf);
@@ -310,7 +314,10 @@ public:
    * @param [in] idx_vec set of indices to put data to
    * @param [in] buff_span a memory span for the data to be put
    */
-  void put(IndexVector idx_vec, span<T> buff_span) { impl_->put(idx_vec, buff_span); }
+  void put(IndexVector idx_vec, span<T> buff_span) {
+    impl_->invalidate_block_norms();
+    impl_->put(idx_vec, buff_span);
+  }
 
   /**
    * @brief nonblocking Put method for Tensor values
@@ -319,6 +326,7 @@ public:
    * @param [in] buff_span a memory span for the data to be put
    */
   void nb_put(IndexVector idx_vec, span<T> buff_span, DataCommunicationHandlePtr data_comm_handle) {
+    impl_->invalidate_block_norms();
     impl_->nb_put(idx_vec, buff_span, data_comm_handle);
   }
 
@@ -328,7 +336,10 @@ public:
    * @param [in] idx_vec set of indices to put data to
    * @param [in] buff_span a memory span for the data to be put
    */
-  void add(IndexVector idx_vec, span<T> buff_span) { impl_->add(idx_vec, buff_span); }
+  void add(IndexVector idx_vec, span<T> buff_span) {
+    impl_->invalidate_block_norms();
+    impl_->add(idx_vec, buff_span);
+  }
 
   /**
    * @brief nonblocking Add method for Tensor values
@@ -337,9 +348,21 @@ public:
    * @param [in] buff_span a memory span for the data to be put
    */
   void nb_add(IndexVector idx_vec, span<T> buff_span, DataCommunicationHandlePtr data_comm_handle) {
+    impl_->invalidate_block_norms();
     impl_->nb_add(idx_vec, buff_span, data_comm_handle);
   }
 
+  /**
+   * @brief Batch accumulates (add) into this tensor per target rank until end_acc_batch().
+   * Other processes are only guaranteed to see them after end_acc_batch().
+   */
+  void begin_acc_batch() { impl_->begin_acc_batch(); }
+
+  /**
+   * @brief Issue all batched accumulates into this tensor and stop batching
+   */
+  void end_acc_batch() { impl_->end_acc_batch(); }
+
   /**
    * @brief Constructs a LabeledLoopNest object  for Tensor object
    *
@@ -469,8 +492,13 @@ public:
 
   bool is_dense() const { return !is_sparse(); }
 
-  T* access_local_buf() { return impl_->access_local_buf(); }
+  /// Writable local buffer: the cached block norms are dropped since they may go stale
+  T* access_local_buf() {
+    impl_->invalidate_block_norms();
+    return impl_->access_local_buf();
+  }
 
+  /// Read-only local buffer, the cached block norms stay valid
   const T* access_local_buf() const { return impl_->access_local_buf(); }
 
   size_t local_buf_size() const { return impl_->local_buf_size(); }
@@ -662,4 +690,39 @@ public:
 template<typename T>
 IndexedTensor(Tensor<T>, IndexVector) -> IndexedTensor<T>;
 
+namespace internal {
+
+/**
+ * @brief Whether the blocks of @p tensor can be addressed in its local buffer through the
+ * tensor's distribution from the ranks of @p ec
+ */
+template<typename T>
+bool has_addressable_local_buf(const Tensor<T>& tensor, const ExecutionContext& ec) {
+  using TensorKind = TensorBase::TensorKind;
+
+  const auto kind = tensor.kind();
+  return kind != TensorKind::view && kind != TensorKind::unit_view && kind != TensorKind::dense &&
+         kind != TensorKind::lambda && tensor.execution_context() != nullptr &&
+         tensor.execution_context()->pg() == ec.pg();
+}
+
+/**
+ * @brief Writable local buffer of @p tensor if has_addressable_local_buf(), nullptr otherwise
+ */
+template<typename T>
+T* local_buf_if_owner(Tensor<T> tensor, const ExecutionContext& ec) {
+  return has_addressable_local_buf(tensor, ec) ? tensor.access_local_buf() : nullptr;
+}
+
+/**
+ * @brief Read-only local buffer of @p tensor if has_addressable_local_buf(), nullptr otherwise.
+ * Unlike local_buf_if_owner(), the cached block norms of the tensor stay valid.
+ */
+template<typename T>
+const T* local_read_buf_if_owner(const Tensor<T>& tensor, const ExecutionContext& ec) {
+  return has_addressable_local_buf(tensor, ec) ? tensor.access_local_buf() : nullptr;
+}
+
+} // namespace internal
+
 } // namespace tamm
@@ -280,6 +280,37 @@ public:
 
   size_t version() const { return version_; }
 
+  /**
+   * @brief Per-block Frobenius norms, keyed by block id, used for norm-based screening of
+   * contractions. Only meaningful while block_norms_valid() holds.
+   */
+  const std::map<IndexVector, double>& block_norms() const { return block_norms_; }
+
+  void set_block_norms(std::map<IndexVector, double> norms) {
+    block_norms_       = std::move(norms);
+    block_norms_valid_ = true;
+  }
+
+  bool block_norms_valid() const { return block_norms_valid_; }
+
+  /// Called by every write to the tensor data
+  void invalidate_block_norms() { block_norms_valid_ = false; }
+
+  /**
+   * @brief Whether the tensor is logically zero while its buffers may still hold stale values.
+   * Only set by a Scheduler during execute(), which zeroes the buffers before they are read.
+   */
+  bool is_lazy_zero() const { return lazy_zero_; }
+
+  void set_lazy_zero(bool lazy_zero) { lazy_zero_ = lazy_zero; }
+
+  /// Zero the buffer of this rank
+  virtual void zero_local_buf() { NOT_ALLOWED(); }
+
+  /// Tensor whose memory holds the data of this tensor: the tensor itself, or the reference
+  /// tensor of a view
+  virtual TensorBase* memory_owner() { return this; }
+
   void clear_updates();
 
 protected:
@@ -344,6 +375,10 @@ protected:
   std::vector<TensorUpdate> updates_;
   size_t                    version_ = 0;
   TensorKind                kind_    = TensorKind::normal;
+
+  std::map<IndexVector, double> block_norms_;
+  bool                          block_norms_valid_ = false;
+  bool                          lazy_zero_         = false;
 }; // TensorBase
 
 inline bool operator<=(const TensorBase& lhs, const TensorBase& rhs) {
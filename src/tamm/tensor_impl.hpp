@@ -521,11 +521,28 @@ public:
     return static_cast<T*>(mpb_->mgr().access(*mpb_, Offset{0}));
   }
 
+  /**
+   * @brief Batch accumulates into this tensor per target rank until end_acc_batch()
+   * (see MemoryManager::begin_batch())
+   */
+  void begin_acc_batch() {
+    if(mpb_ != nullptr) mpb_->begin_batch();
+  }
+
+  /**
+   * @brief Issue all batched accumulates into this tensor and stop batching
+   */
+  void end_acc_batch() {
+    if(mpb_ != nullptr) mpb_->end_batch();
+  }
+
   virtual size_t local_buf_size() const {
     EXPECTS(mpb_);
     return mpb_->local_nelements().value();
   }
 
+  void zero_local_buf() override { kernels::flat::set(access_local_buf(), T{0}, local_buf_size()); }
+
   virtual size_t total_buf_size(Proc proc) const {
     EXPECTS(distribution_);
     return distribution_->buf_size(proc).value();
@@ -1535,6 +1552,8 @@ public:
     // update_status(AllocationStatus::created);
   }
 
+  TensorBase* memory_owner() override { return ref_tensor_.base_ptr()->memory_owner(); }
+
   const Distribution& distribution() const override {
     // return ref_tensor_.distribution();
     return *distribution_.get();
@@ -1749,6 +1768,8 @@ public:
     // update_status(AllocationStatus::deallocated);
   }
 
+  TensorBase* memory_owner() override { return tensor_opt_.base_ptr()->memory_owner(); }
+
   /**
    * @brief Virtual method implementation for allocating a unit tiled view tensor using an
    * ExecutionContext
@@ -7,7 +7,9 @@
 #include "tamm/boundvec.hpp"
 #include "tamm/errors.hpp"
 #include "tamm/strong_num.hpp"
+#include <algorithm>
 #include <complex>
+#include <functional>
 #include <iosfwd>
 #include <map>
 #if defined(USE_UPCXX)
@@ -90,6 +92,11 @@ using SizeVec  = std::vector<Size>;
 using ProcGrid = std::vector<Proc>;
 using ProcList = std::vector<int>;
 
+/// Optional per-element epilogue of MultOp/AddOp: maps the global indices of an output
+/// element and the computed update to the value accumulated (or assigned) into the output.
+template<typename T>
+using ElementEpilogue = std::function<T(const std::vector<size_t>&, T)>;
+
 enum class AllocationStatus { invalid, created, attached, deallocated, orphaned };
 
 enum class ElementType {
@@ -258,6 +265,20 @@ static inline MPI_Op mpi_op(ReduceOp rop) {
 #endif
 
 namespace internal {
+/// Threads available to the block kernels (transposes, element-wise updates) run by the calling
+/// thread. Set from ExecutionContext::kernel_threads() while a Scheduler executes.
+inline int& kernel_threads() {
+  static thread_local int nthreads = 1;
+  return nthreads;
+}
+
+/// Threads to use for a block kernel over @p nelements elements: small blocks stay serial
+inline int kernel_threads(size_t nelements) {
+  constexpr size_t min_elements_per_thread = 1 << 14;
+  return static_cast<int>(std::clamp<size_t>(nelements / min_elements_per_thread, 1,
+                                             static_cast<size_t>(kernel_threads())));
+}
+
 template<typename T, typename... Args>
 void unfold_vec(std::vector<T>& v, Args&&... args) {
   static_assert((std::is_constructible_v<T, Args&&> && ...));
@@ -42,6 +42,34 @@ struct is_complex<std::complex<T>>: std::true_type {};
 template<typename T>
 inline constexpr bool is_complex_v = is_complex<T>::value;
 
+/// True if T2 and/or T3 hold the same kind of values as T1 (real or complex) but in a
+/// lower precision, e.g. a double-precision output computed from single-precision inputs.
+template<typename T1, typename T2, typename T3>
+inline constexpr bool is_mixed_precision_v =
+  !(std::is_same_v<T1, T2> && std::is_same_v<T1, T3>) && is_complex_v<T1> == is_complex_v<T2> &&
+  is_complex_v<T1> == is_complex_v<T3> && sizeof(T2) <= sizeof(T1) && sizeof(T3) <= sizeof(T1);
+
+/**
+ * @brief Apply @p epilogue to every element of a row-major block with dimensions @p dims
+ * whose first element has global indices @p offsets.
+ */
+template<typename T>
+void apply_epilogue(const ElementEpilogue<T>& epilogue, T* buf, const std::vector<size_t>& dims,
+                    const std::vector<size_t>& offsets) {
+  EXPECTS(dims.size() == offsets.size());
+  const size_t nd = dims.size();
+  size_t       n  = 1;
+  for(const auto d: dims) n *= d;
+  std::vector<size_t> gidx{offsets};
+  for(size_t e = 0; e < n; e++) {
+    buf[e] = epilogue(gidx, buf[e]);
+    for(size_t d = nd; d-- > 0;) {
+      if(++gidx[d] < offsets[d] + dims[d]) break;
+      gidx[d] = offsets[d];
+    }
+  }
+}
+
 inline void update_fillin_map(std::map<std::string, Label>&   str_to_labels,
                               const std::vector<bool>&        str_map,
                               const std::vector<std::string>& str_labels, int initial_off) {
@@ -0,0 +1,80 @@
+#include <tamm/kernels/flat_ops.hpp>
+
+#include <chrono>
+#include <complex>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Memory bandwidth of the flat block kernels for every supported ISA. Not part of the unit
+// tests: the numbers depend on the machine and nothing is checked.
+
+using namespace tamm;
+using namespace tamm::kernels;
+
+namespace {
+
+std::vector<flat::SimdISA> supported_isas() {
+  std::vector<flat::SimdISA> isas{flat::SimdISA::generic};
+  if(flat::simd_isa() != flat::SimdISA::generic) isas.push_back(flat::SimdISA::avx2);
+  if(flat::simd_isa() == flat::SimdISA::avx512) isas.push_back(flat::SimdISA::avx512);
+  return isas;
+}
+
+template<typename T>
+T make_value(size_t i) {
+  if constexpr(internal::is_complex_v<T>) return T(0.5 + i % 7, 1.0 + i % 5);
+  else return static_cast<T>(0.5 + i % 7);
+}
+
+/// Best-of-5 bandwidth of @p op in GB/s, given the number of elements it reads and writes
+template<typename T, typename Op>
+double bandwidth(size_t n, size_t nstreams, Op op) {
+  double best = 0;
+  for(int rep = 0; rep < 5; rep++) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    op();
+    auto t1   = std::chrono::high_resolution_clock::now();
+    auto secs = std::chrono::duration<double>(t1 - t0).count();
+    best      = std::max(best, nstreams * n * sizeof(T) / secs / 1e9);
+  }
+  return best;
+}
+
+template<typename T>
+void bench_flat_ops(const std::string& type) {
+  const size_t   n = size_t{1} << 22;
+  const T        a = make_value<T>(3), b = make_value<T>(4);
+  std::vector<T> x(n, make_value<T>(1)), y(n, make_value<T>(2)), z(n, make_value<T>(0));
+
+  for(auto isa: supported_isas()) {
+    const double set_bw   = bandwidth<T>(n, 1, [&] { flat::set(z.data(), a, n, isa); });
+    const double scale_bw = bandwidth<T>(n, 2, [&] { flat::scale(z.data(), a, x.data(), n, isa); });
+    const double axpby_bw =
+      bandwidth<T>(n, 3, [&] { flat::axpby(z.data(), b, a, x.data(), n, isa); });
+    const double hadamard_bw =
+      bandwidth<T>(n, 3, [&] { flat::hadamard(z.data(), T{0}, a, x.data(), y.data(), n, isa); });
+    const double divide_bw =
+      bandwidth<T>(n, 3, [&] { flat::divide(z.data(), x.data(), y.data(), n, isa); });
+    std::cout << std::setw(8) << type << std::setw(9) << flat::to_string(isa) << std::fixed
+              << std::setprecision(1) << std::setw(10) << set_bw << std::setw(10) << scale_bw
+              << std::setw(10) << axpby_bw << std::setw(10) << hadamard_bw << std::setw(10)
+              << divide_bw << std::endl;
+  }
+}
+
+} // namespace
+
+int main() {
+  std::cout << "Flat kernel bandwidth in GB/s (detected ISA: " << flat::to_string(flat::simd_isa())
+            << ")\n"
+            << std::setw(8) << "type" << std::setw(9) << "isa" << std::setw(10) << "set"
+            << std::setw(10) << "scale" << std::setw(10) << "axpby" << std::setw(10) << "hadamard"
+            << std::setw(10) << "divide" << std::endl;
+  bench_flat_ops<double>("double");
+  bench_flat_ops<float>("float");
+  bench_flat_ops<std::complex<double>>("cdouble");
+  bench_flat_ops<std::complex<float>>("cfloat");
+  return 0;
+}
@@ -0,0 +1,93 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+#include <tamm/kernels/flat_ops.hpp>
+
+#include <complex>
+#include <vector>
+
+using namespace tamm;
+using namespace tamm::kernels;
+
+namespace {
+
+std::vector<flat::SimdISA> supported_isas() {
+  std::vector<flat::SimdISA> isas{flat::SimdISA::generic};
+  if(flat::simd_isa() != flat::SimdISA::generic) isas.push_back(flat::SimdISA::avx2);
+  if(flat::simd_isa() == flat::SimdISA::avx512) isas.push_back(flat::SimdISA::avx512);
+  return isas;
+}
+
+template<typename T>
+T make_value(size_t i) {
+  if constexpr(internal::is_complex_v<T>) return T(0.5 + i % 7, 1.0 + i % 5);
+  else return static_cast<T>(0.5 + i % 7);
+}
+
+template<typename T>
+bool close(T a, T b) {
+  const double tol = std::is_same_v<T, float> || std::is_same_v<T, std::complex<float>> ? 1e-4
+                                                                                       : 1e-10;
+  return std::abs(a - b) <= tol * (1.0 + std::abs(b));
+}
+
+template<typename T>
+void check_flat_ops(flat::SimdISA isa) {
+  // odd size so the vector loops have a remainder
+  const size_t   n = 1003;
+  const T        a = make_value<T>(3), b = make_value<T>(4);
+  std::vector<T> x(n), y(n), z(n), ref(n);
+  for(size_t i = 0; i < n; i++) {
+    x[i] = make_value<T>(i);
+    y[i] = make_value<T>(i + 2);
+  }
+  auto check = [&](const char* op) {
+    for(size_t i = 0; i < n; i++) {
+      INFO(op << " " << flat::to_string(isa) << " at " << i);
+      REQUIRE(close(z[i], ref[i]));
+    }
+  };
+
+  flat::set(z.data(), a, n, isa);
+  for(size_t i = 0; i < n; i++) ref[i] = a;
+  check("set");
+
+  flat::copy(z.data(), x.data(), n);
+  for(size_t i = 0; i < n; i++) ref[i] = x[i];
+  check("copy");
+
+  flat::scale(z.data(), a, x.data(), n, isa);
+  for(size_t i = 0; i < n; i++) ref[i] = a * x[i];
+  check("scale");
+
+  flat::axpy(z.data(), b, y.data(), n, isa);
+  for(size_t i = 0; i < n; i++) ref[i] += b * y[i];
+  check("axpy");
+
+  flat::axpby(z.data(), b, a, x.data(), n, isa);
+  for(size_t i = 0; i < n; i++) ref[i] = b * ref[i] + a * x[i];
+  check("axpby");
+
+  flat::hadamard(z.data(), T{0}, a, x.data(), y.data(), n, isa);
+  for(size_t i = 0; i < n; i++) ref[i] = a * x[i] * y[i];
+  check("hadamard");
+
+  flat::hadamard(z.data(), b, T{1}, x.data(), y.data(), n, isa);
+  for(size_t i = 0; i < n; i++) ref[i] = b * ref[i] + x[i] * y[i];
+  check("hadamard update");
+
+  flat::divide(z.data(), x.data(), y.data(), n, isa);
+  for(size_t i = 0; i < n; i++) ref[i] = x[i] / y[i];
+  check("divide");
+}
+
+} // namespace
+
+TEST_CASE("Flat block kernels") {
+  for(auto isa: supported_isas()) {
+    check_flat_ops<double>(isa);
+    check_flat_ops<float>(isa);
+    check_flat_ops<std::complex<double>>(isa);
+    check_flat_ops<std::complex<float>>(isa);
+  }
+}
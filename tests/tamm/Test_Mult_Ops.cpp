@@ -158,6 +158,388 @@ void test_3_dim_mult_op(Scheduler& sch, size_t N, Tile tilesize, ExecutionHW ex_
   sch.deallocate(A, B, C).execute();
 }
 
+// A and B stored in TL (e.g. float), C accumulated in TH (e.g. double)
+template<typename TL, typename TH>
+void test_2_dim_mult_op_mixed(Scheduler& sch, size_t N, Tile tilesize, ExecutionHW ex_hw,
+                              bool profile) {
+  TiledIndexSpace tis1{IndexSpace{range(N)}, tilesize};
+
+  auto [i, j, k] = tis1.labels<3>("all");
+
+  Tensor<TL> A{i, k};
+  Tensor<TL> B{k, j};
+  Tensor<TH> C{i, j};
+
+  sch.allocate(A, B, C)(A() = TL{21})(B() = TL{2})(C() = TH{0}).execute();
+
+  const auto timer_start = std::chrono::high_resolution_clock::now();
+
+  sch(C(i, j) += A(i, k) * B(k, j)).execute(ex_hw, profile);
+
+  const auto timer_end = std::chrono::high_resolution_clock::now();
+
+  auto mult_time =
+    std::chrono::duration_cast<std::chrono::duration<double>>((timer_end - timer_start)).count();
+
+  // every element of C is 42*N
+  const double cnorm    = std::abs(tamm::norm(C));
+  const double expected = 42.0 * N * N;
+  const bool   mop_pass = std::fabs(cnorm - expected) <= 1e-12 * expected;
+
+  if(sch.ec().print())
+    std::cout << "2-D mixed precision Tensor contraction with " << N << " indices tiled with "
+              << tilesize << " : " << mult_time << std::endl;
+  if(!mop_pass) {
+    if(sch.ec().print())
+      std::cout << "norm value: " << cnorm << ", expected: " << expected << std::endl;
+    EXPECTS(mop_pass);
+  }
+
+  sch.deallocate(A, B, C).execute();
+}
+
+// Sets every element (r, c) of a matrix to f(r, c), converted to the element type of t
+template<typename T, typename Func>
+void fill_2d(Tensor<T>& t, Func f) {
+  fill_tensor<T>(t, [&](const IndexVector& blockid, span<T> buf) {
+    const auto dims = t.block_dims(blockid);
+    const auto offs = t.block_offsets(blockid);
+    for(size_t r = 0; r < dims[0]; r++)
+      for(size_t c = 0; c < dims[1]; c++)
+        buf[r * dims[1] + c] = static_cast<T>(f(offs[0] + r, offs[1] + c));
+  });
+}
+
+// Contractions in single precision T (float or std::complex<float>) against the same
+// contractions in TRef (double or std::complex<double>)
+template<typename T, typename TRef>
+void test_single_precision_mult_op(Scheduler& sch, size_t N, Tile tilesize) {
+  TiledIndexSpace tis1{IndexSpace{range(N)}, tilesize};
+
+  auto [i, j, k] = tis1.labels<3>("all");
+
+  Tensor<T>    A{i, k}, B{k, j}, C{i, j};
+  Tensor<TRef> Aref{i, k}, Bref{k, j}, Cref{i, j};
+  sch.allocate(A, B, C, Aref, Bref, Cref).execute();
+
+  auto value = [](size_t r, size_t c, double shift) {
+    const double x = 1.0 / (1.0 + r + 2.0 * c) - shift;
+    if constexpr(internal::is_complex_v<TRef>) return TRef{x, 0.5 - x};
+    else return TRef{x};
+  };
+  fill_2d(A, [&](size_t r, size_t c) { return value(r, c, 0.1); });
+  fill_2d(Aref, [&](size_t r, size_t c) { return value(r, c, 0.1); });
+  fill_2d(B, [&](size_t r, size_t c) { return value(r, c, 0.3); });
+  fill_2d(Bref, [&](size_t r, size_t c) { return value(r, c, 0.3); });
+
+  // a plain GEMM, then one that permutes both operands
+  sch(C() = T{0})(Cref() = TRef{0})(C(i, j) += A(i, k) * B(k, j))(
+    Cref(i, j) += Aref(i, k) * Bref(k, j))(C(i, j) += 0.5 * A(k, i) * B(j, k))(
+    Cref(i, j) += 0.5 * Aref(k, i) * Bref(j, k))
+    .execute();
+
+  // the rounding error of an N-term sum of single precision products grows with N
+  const double tol      = 1e-6 * N;
+  bool         mop_pass = true;
+  for(const IndexVector& blockid: C.loop_nest()) {
+    std::vector<T>    buf(C.block_size(blockid));
+    std::vector<TRef> ref(buf.size());
+    C.get(blockid, buf);
+    Cref.get(blockid, ref);
+    for(size_t e = 0; e < buf.size(); e++) {
+      if(std::abs(static_cast<TRef>(buf[e]) - ref[e]) > tol * std::max(1.0, std::abs(ref[e])))
+        mop_pass = false;
+    }
+  }
+
+  if(!mop_pass && sch.ec().print())
+    std::cout << "single precision contraction differs from its reference" << std::endl;
+  EXPECTS(mop_pass);
+
+  sch.deallocate(A, B, C, Aref, Bref, Cref).execute();
+}
+
+template<typename T>
+void test_block_norms(Scheduler& sch, size_t N, Tile tilesize) {
+  TiledIndexSpace tis1{IndexSpace{range(N)}, tilesize};
+
+  auto [i, j] = tis1.labels<2>("all");
+
+  Tensor<T> A{i, j};
+  sch.allocate(A)(A() = T{3}).execute();
+
+  tamm::internal::update_block_norms(sch.ec(), A);
+  EXPECTS(A.base_ptr()->block_norms_valid());
+
+  // sum of squared block norms is the squared norm of the tensor
+  double nrm2 = 0;
+  for(const auto& [blockid, bnorm]: A.base_ptr()->block_norms()) nrm2 += bnorm * bnorm;
+  const double expected = 9.0 * N * N;
+  EXPECTS(std::fabs(nrm2 - expected) <= 1e-12 * expected);
+
+  // reading the tensor as an operand keeps them
+  Tensor<T> B{i, j};
+  sch.allocate(B)(B(i, j) = A(i, j))(B(i, j) += 2.0 * A(j, i)).execute();
+  EXPECTS(A.base_ptr()->block_norms_valid());
+
+  // writing the tensor invalidates its block norms
+  sch(A() = T{1}).execute();
+  EXPECTS(!A.base_ptr()->block_norms_valid());
+
+  sch.deallocate(A, B).execute();
+}
+
+template<typename T>
+void test_accumulation_cache(Scheduler& sch, size_t N, Tile tilesize) {
+  TiledIndexSpace tis1{IndexSpace{range(N)}, tilesize};
+
+  auto [i, j] = tis1.labels<2>("all");
+
+  Tensor<T> C{i, j};
+  sch.allocate(C)(C() = T{0}).execute();
+
+  // budget of a single block: every new block evicts the previous one
+  const IndexVector blockid{0, 0};
+  const size_t      bsize = C.block_size(blockid);
+  if(sch.ec().pg().rank() == 0) {
+    std::vector<T> buf(bsize, T{1});
+    {
+      tamm::internal::AccumulationCache<T> cache{C, bsize * sizeof(T)};
+      cache.add(blockid, {buf.data(), bsize});
+      cache.add(blockid, {buf.data(), bsize});
+      EXPECTS(cache.num_combined() == 1);
+      if(tis1.num_tiles() > 1) {
+        const IndexVector blockid2{1, 0};
+        const size_t      bsize2 = C.block_size(blockid2);
+        std::vector<T>    buf2(bsize2, T{1});
+        cache.add(blockid2, {buf2.data(), bsize2}); // evicts {0,0}
+        cache.add(blockid, {buf.data(), bsize});
+      }
+    } // flushed on destruction
+  }
+  sch.ec().pg().barrier();
+
+  std::vector<T> cbuf(bsize);
+  C.get(blockid, {cbuf.data(), bsize});
+  const T expected = tis1.num_tiles() > 1 ? T{3} : T{2};
+  for(const auto v: cbuf) EXPECTS(v == expected);
+
+  sch.deallocate(C).execute();
+}
+
+void test_kernel_tuner(ProcGroup pg) {
+  using tamm::kernels::MultKernelTuner;
+  using tamm::kernels::MultVariant;
+  auto& tuner = MultKernelTuner::instance();
+
+  // keys only depend on the label pattern, not on the label values
+  const SizeVec dims{3, 4};
+  const auto    key = MultKernelTuner::make_key<double>({7, 9}, dims, {9, 7}, {4, 3}, {7});
+  EXPECTS(key == MultKernelTuner::make_key<double>({1, 2}, dims, {2, 1}, {4, 3}, {1}));
+  EXPECTS(key != MultKernelTuner::make_key<float>({1, 2}, dims, {2, 1}, {4, 3}, {1}));
+
+  // every variant is sampled before a winner is fixed
+  tuner.set_tuning(true);
+  for(int s = 0; s < MultKernelTuner::nvariants * MultKernelTuner::nsamples; s++) {
+    EXPECTS(!tuner.tuned(key));
+    const auto v = tuner.select(key);
+    tuner.record(key, v, v == MultVariant::direct ? 1.0 : 2.0);
+  }
+  EXPECTS(tuner.tuned(key) && tuner.select(key) == MultVariant::direct);
+
+  // only rank 0 samples, the other ranks run TTGT until they adopt its decision
+  const bool root = pg.rank() == 0;
+  const auto key2 = MultKernelTuner::make_key<double>({1, 2}, {5, 6}, {2, 1}, {6, 5}, {1});
+  tuner.set_tuning(root);
+  for(int s = 0; s < MultKernelTuner::nvariants * MultKernelTuner::nsamples; s++) {
+    const auto v = tuner.select(key2);
+    EXPECTS(root || v == MultVariant::ttgt);
+    tuner.record(key2, v, v == MultVariant::direct ? 1.0 : 2.0);
+  }
+  EXPECTS(tuner.tuned(key2) == root);
+  tuner.sync(pg);
+  EXPECTS(tuner.tuned(key2) && tuner.select(key2) == MultVariant::direct);
+  tuner.set_tuning(true);
+
+  // direct kernel: C(i,j) = A(k,i) * B(j,k)
+  const size_t        ni = 3, nj = 2, nk = 4;
+  std::vector<double> a(nk * ni), b(nj * nk), c(ni * nj, 1.0);
+  std::iota(a.begin(), a.end(), 0.0);
+  std::iota(b.begin(), b.end(), 1.0);
+  tamm::kernels::direct_multiply(2.0, a.data(), {nk, ni}, {2, 0}, b.data(), {nj, nk}, {1, 2},
+                                 c.data(), {ni, nj}, {0, 1}, false, {}, {}, {0}, {ni}, {1}, {nj},
+                                 {2}, {nk});
+  for(size_t i = 0; i < ni; i++) {
+    for(size_t j = 0; j < nj; j++) {
+      double ref = 1.0;
+      for(size_t k = 0; k < nk; k++) ref += 2.0 * a[k * ni + i] * b[j * nk + k];
+      EXPECTS(c[i * nj + j] == ref);
+    }
+  }
+}
+
+void test_kpanel_gemm() {
+  // C(i,j) = 0.5 * A(i,k) * B(k,j) from reduction tiles of widths 3, 3, 3, 2 and 7, with a
+  // budget of 5 K-columns: the panels are flushed several times and grown for the last tile
+  const int           M = 3, N = 4;
+  const size_t        widths[] = {3, 3, 3, 2, 7};
+  std::vector<double> c(M * N, -1.0), ref(M * N, 0.0);
+  tamm::kernels::KPanelGemm<double> kagg{0.5, M, N, 5 * (2 * M + N) * sizeof(double), c.data()};
+  size_t k0 = 0;
+  for(const size_t K: widths) {
+    std::vector<double> a(M * K), b(K * N);
+    for(size_t x = 0; x < a.size(); x++) a[x] = 0.1 * x - 0.3 * k0;
+    for(size_t x = 0; x < b.size(); x++) b[x] = 1.0 / (1.0 + x + k0);
+    kagg.pack(a.data(), {M, K}, {0, 2}, {M, K}, {0, 2}, b.data(), {K, N}, {2, 1}, {K, N}, {2, 1},
+              static_cast<int>(K));
+    for(int i = 0; i < M; i++) {
+      for(int j = 0; j < N; j++) {
+        for(size_t k = 0; k < K; k++) ref[i * N + j] += 0.5 * a[i * K + k] * b[k * N + j];
+      }
+    }
+    k0 += K;
+  }
+  kagg.flush();
+  EXPECTS(kagg.ntiles() == 5 && kagg.nflushes() >= 3);
+  for(int x = 0; x < M * N; x++) EXPECTS(std::abs(c[x] - ref[x]) < 1e-10);
+}
+
+void test_block_multiply_beta() {
+  // C = beta * C + alpha * A(i,k) * B(k,j), and C = alpha * A * B for an assign, both with C
+  // in GEMM order [i,j] (written by the GEMM directly) and permuted [j,i] (via the intermediate)
+  const size_t        ni = 3, nj = 4, nk = 5;
+  std::vector<double> a(ni * nk), b(nk * nj);
+  std::iota(a.begin(), a.end(), 1.0);
+  std::iota(b.begin(), b.end(), -2.0);
+  gpuStream_t thandle{};
+
+  for(const bool transposed: {false, true}) {
+    const SizeVec     cdims   = transposed ? SizeVec{nj, ni} : SizeVec{ni, nj};
+    const IntLabelVec clabels = transposed ? IntLabelVec{1, 0} : IntLabelVec{0, 1};
+    for(const bool is_assign: {false, true}) {
+      const double        alpha = 0.5, beta = 2.0;
+      std::vector<double> c(ni * nj);
+      std::iota(c.begin(), c.end(), 3.0);
+      const auto c0 = c;
+      double *   cdev{nullptr}, *ctmp{nullptr};
+      tamm::kernels::block_multiply<double, double, double, double>(
+#if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
+        a.data(), b.data(),
+#endif
+        thandle, alpha, a.data(), {ni, nk}, {0, 2}, b.data(), {nk, nj}, {2, 1}, beta, c.data(),
+        cdims, clabels, ExecutionHW::CPU, is_assign, cdev, ctmp);
+      for(size_t i = 0; i < ni; i++) {
+        for(size_t j = 0; j < nj; j++) {
+          const size_t ci  = transposed ? j * ni + i : i * nj + j;
+          double       ref = is_assign ? 0.0 : beta * c0[ci];
+          for(size_t k = 0; k < nk; k++) ref += alpha * a[i * nk + k] * b[k * nj + j];
+          EXPECTS(std::abs(c[ci] - ref) < 1e-10);
+        }
+      }
+    }
+  }
+}
+
+void test_block_multiply_mixed() {
+  // C = CxR and C = RxC with complex alpha and non-zero imaginary parts, through the interleaved
+  // real GEMM, against a naive reference: C(i,j) += alpha * A(i,k) * B(k,j)
+  using Z = std::complex<double>;
+
+  const size_t ni = 3, nj = 4, nk = 5;
+  std::vector<Z>      z(std::max(ni * nk, nk * nj));
+  std::vector<double> r(z.size());
+  for(size_t x = 0; x < z.size(); x++) {
+    z[x] = Z(0.5 * x + 1.0, 2.0 - 0.25 * x);
+    r[x] = 1.5 - 0.5 * x;
+  }
+  const Z     alpha{0.5, -1.5};
+  gpuStream_t thandle{};
+
+  for(const bool a_is_real: {false, true}) {
+    std::vector<Z> c(ni * nj);
+    for(size_t x = 0; x < c.size(); x++) c[x] = Z(x, -1.0 * x);
+    const auto c0 = c;
+    Z *        cdev{nullptr}, *ctmp{nullptr};
+    // C is laid out [j,i] so the result is permuted into place
+    if(a_is_real) {
+      tamm::kernels::block_multiply<Z, Z, double, Z>(
+#if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
+        r.data(), z.data(),
+#endif
+        thandle, alpha, r.data(), {ni, nk}, {0, 2}, z.data(), {nk, nj}, {2, 1}, Z{1}, c.data(),
+        {nj, ni}, {1, 0}, ExecutionHW::CPU, false, cdev, ctmp);
+    }
+    else {
+      tamm::kernels::block_multiply<Z, Z, Z, double>(
+#if defined(USE_CUDA) || defined(USE_HIP) || defined(USE_DPCPP)
+        z.data(), r.data(),
+#endif
+        thandle, alpha, z.data(), {ni, nk}, {0, 2}, r.data(), {nk, nj}, {2, 1}, Z{1}, c.data(),
+        {nj, ni}, {1, 0}, ExecutionHW::CPU, false, cdev, ctmp);
+    }
+    for(size_t i = 0; i < ni; i++) {
+      for(size_t j = 0; j < nj; j++) {
+        Z ref = c0[j * ni + i];
+        for(size_t k = 0; k < nk; k++) {
+          const Z a = a_is_real ? Z(r[i * nk + k]) : z[i * nk + k];
+          const Z b = a_is_real ? z[k * nj + j] : Z(r[k * nj + j]);
+          ref += alpha * a * b;
+        }
+        EXPECTS(std::abs(c[j * ni + i] - ref) < 1e-10);
+      }
+    }
+  }
+}
+
+template<typename T>
+void test_assign_mult_op(Scheduler& sch, size_t N, Tile tilesize) {
+  TiledIndexSpace tis1{IndexSpace{range(N)}, tilesize};
+  auto [i, j, k] = tis1.labels<3>("all");
+
+  Tensor<T> A{i, k};
+  Tensor<T> B{k, j};
+  Tensor<T> C{i, j};
+
+  // the assign form overwrites the stale contents of C, in both C layouts
+  sch.allocate(A, B, C)(A() = 3.0)(B() = 2.0)(C() = 7.0).execute();
+  sch(C(i, j) = A(i, k) * B(k, j)).execute();
+  EXPECTS(tamm::sum(C) == T(6.0 * N * N * N));
+  sch(C() = 7.0)(C(j, i) = 0.5 * A(i, k) * B(k, j)).execute();
+  EXPECTS(tamm::sum(C) == T(3.0 * N * N * N));
+
+  sch.deallocate(A, B, C).execute();
+}
+
+template<typename T>
+void test_cholesky_contract(Scheduler& sch, size_t N, Tile tilesize) {
+  TiledIndexSpace tis1{IndexSpace{range(N)}, tilesize};
+  TiledIndexSpace tisq{IndexSpace{range(2 * N)}, tilesize};
+
+  auto [a, b, i, j] = tis1.labels<4>("all");
+  auto [q]          = tisq.labels<1>("all");
+
+  Tensor<T> L{tis1, tis1, tisq};
+  Tensor<T> X{tis1, tis1, tis1, tis1}; // never allocated
+  sch.allocate(L)(L() = T{1}).execute();
+
+  // X(a,b,i,j) = 0.5 * sum_q L(a,i,q) * L(b,j,q) = N, consumed without storing X
+  double local_sum = 0;
+  tamm::cholesky_contract<T>(sch.ec(), X(a, b, i, j), T{0.5}, L(a, i, q), L(b, j, q),
+                             [&](const IndexVector&, span<T> blk) {
+                               for(const auto v: blk) local_sum += v;
+                             });
+  double sum = 0;
+  sch.ec().pg().allreduce(&local_sum, &sum, 1, ReduceOp::sum);
+
+  const double expected = 1.0 * N * N * N * N * N;
+  if(std::fabs(sum - expected) > 1e-12 * expected) {
+    if(sch.ec().print()) std::cout << "sum: " << sum << ", expected: " << expected << std::endl;
+    EXPECTS(false);
+  }
+
+  sch.deallocate(L).execute();
+}
+
 template<typename T>
 void norm_check(Tensor<T> tensor, bool ci_check) {
   if(!ci_check) return;
@@ -463,6 +845,17 @@ int main(int argc, char* argv[]) {
   // test_2_dim_mult_op<double>(sch, is_size, tile_size, ex_hw, profile);
   // test_3_dim_mult_op<double>(sch, is_size, tile_size, ex_hw, profile);
   test_4_dim_mult_op<double>(sch, is_size, tile_size, ex_hw, profile);
+  test_2_dim_mult_op_mixed<float, double>(sch, is_size, tile_size, ex_hw, profile);
+  test_single_precision_mult_op<float, double>(sch, is_size, tile_size);
+  test_single_precision_mult_op<std::complex<float>, std::complex<double>>(sch, is_size, tile_size);
+  test_block_norms<double>(sch, is_size, tile_size);
+  test_cholesky_contract<double>(sch, is_size, tile_size);
+  test_accumulation_cache<double>(sch, is_size, tile_size);
+  test_kernel_tuner(ec.pg());
+  test_kpanel_gemm();
+  test_block_multiply_beta();
+  test_block_multiply_mixed();
+  test_assign_mult_op<double>(sch, is_size, tile_size);
   // test_4_dim_mult_op_last_unit<double>(sch, is_size, tile_size);
   // test_4_dim_mult_op_first_unit<double>(sch, is_size, tile_size);
 
@@ -53,6 +53,54 @@ void check_value(Tensor<T>& t, T val) {
   check_value(t(), val);
 }
 
+/// Calls f(c, idx) for every element c of a block, with idx its global element indices
+template<typename T, typename Func>
+void for_each_element(Tensor<T>& t, const IndexVector& blockid, Func f) {
+  const auto          dims    = t.block_dims(blockid);
+  const auto          offsets = t.block_offsets(blockid);
+  std::vector<size_t> idx(offsets.begin(), offsets.end());
+  const size_t        size = t.block_size(blockid);
+  for(size_t c = 0; c < size; c++) {
+    f(c, idx);
+    for(int d = static_cast<int>(idx.size()) - 1; d >= 0; d--) {
+      if(++idx[d] < offsets[d] + dims[d]) break;
+      idx[d] = offsets[d];
+    }
+  }
+}
+
+/// Sets every element of t to f(global element indices). Collective.
+template<typename T, typename Func>
+void fill_by_index(Tensor<T>& t, Func f) {
+  fill_tensor<T>(t, [&](const IndexVector& blockid, span<T> buf) {
+    for_each_element(t, blockid,
+                     [&](size_t c, const std::vector<size_t>& idx) { buf[c] = f(idx); });
+  });
+}
+
+/// Checks every element of t against f(global element indices)
+template<typename T, typename Func>
+void check_by_index(Tensor<T>& t, Func f, double tol = 1.0e-10) {
+  for(const IndexVector& blockid: t.loop_nest()) {
+    std::vector<T> buf(t.block_size(blockid));
+    t.get(blockid, buf);
+    for_each_element(t, blockid, [&](size_t c, const std::vector<size_t>& idx) {
+      REQUIRE(std::abs(buf[c] - static_cast<T>(f(idx))) < tol);
+    });
+  }
+}
+
+/// Checks that two tensors with the same shape hold the same values
+template<typename T>
+void check_equal(Tensor<T>& t, Tensor<T>& ref, double tol = 1.0e-10) {
+  for(const IndexVector& blockid: t.loop_nest()) {
+    std::vector<T> buf(t.block_size(blockid)), rbuf(ref.block_size(blockid));
+    t.get(blockid, buf);
+    ref.get(blockid, rbuf);
+    for(size_t c = 0; c < buf.size(); c++) REQUIRE(std::abs(buf[c] - rbuf[c]) < tol);
+  }
+}
+
 template<typename T>
 void test_ops(const TiledIndexSpace& MO) {
   const TiledIndexSpace& O = MO("occ");
@@ -1982,3 +2030,679 @@ TEST_CASE("MultOp with RHS reduction") {
   }
   REQUIRE(!failed);
 }
+
+TEST_CASE("Ops with element epilogue") {
+  bool              failed;
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  IndexSpace      IS{range(0, 4)};
+  TiledIndexSpace TIS{IS, 3};
+
+  try {
+    failed = false;
+    Tensor<T>       T1{TIS, TIS}, T2{TIS, TIS}, T3{TIS, TIS};
+    TiledIndexLabel i, j, k;
+    std::tie(i, j, k) = TIS.labels<3>("all");
+
+    auto diag = [](const std::vector<size_t>& idx, T v) { return idx[0] == idx[1] ? v : T{0}; };
+    auto rowscale = [](const std::vector<size_t>& idx, T v) { return v * (idx[0] + 1); };
+
+    Scheduler{*ec}
+      .allocate(T1, T2, T3)(T1() = 0)(T2() = 2)(T3() = 3)(
+        (T1(i, j) += T2(i, k) * T3(k, j)).set_epilogue(diag))(
+        (T1(i, j) += 2.0 * T2(i, j)).set_epilogue(rowscale))
+      .deallocate(T2, T3)
+      .execute();
+
+    for(const IndexVector& blockid: T1.loop_nest()) {
+      const auto     dims    = T1.block_dims(blockid);
+      const auto     offsets = T1.block_offsets(blockid);
+      std::vector<T> buf(T1.block_size(blockid));
+      T1.get(blockid, buf);
+      size_t c = 0;
+      for(size_t r = offsets[0]; r < offsets[0] + dims[0]; r++) {
+        for(size_t s = offsets[1]; s < offsets[1] + dims[1]; s++, c++) {
+          const T expected = (r == s ? 2.0 * 3.0 * 4 : 0.0) + 4.0 * (r + 1);
+          REQUIRE(std::abs(buf[c] - expected) < 1.0e-10);
+        }
+      }
+    }
+    Tensor<T>::deallocate(T1);
+  } catch(std::string& e) {
+    std::cerr << "Caught exception: " << e << "\n";
+    failed = true;
+  }
+  REQUIRE(!failed);
+}
+
+TEST_CASE("HPTT plan reuse") {
+  using T     = double;
+  auto& plans = tamm::internal::HPTTPlanCache::instance();
+
+  const SizeVec     sdims{8, 16, 10}, ddims{10, 8, 16};
+  const IntLabelVec slabels{0, 1, 2}, dlabels{2, 0, 1};
+
+  std::vector<T> src(1280), dst(1280, T{1});
+  std::iota(src.begin(), src.end(), T{0});
+
+  const size_t created = plans.num_created();
+  const size_t hits    = plans.num_hits();
+  kernels::assign(dst.data(), ddims, dlabels, T{2}, src.data(), sdims, slabels, true);
+  kernels::assign(dst.data(), ddims, dlabels, T{2}, src.data(), sdims, slabels, true);
+  if(tamm::detail::tamm_hptt_plan_cache_size > 0) {
+    REQUIRE(plans.num_created() == created + 1);
+    REQUIRE(plans.num_hits() == hits + 1);
+  }
+
+  // a different scale reuses the plan with the new factor
+  kernels::assign(dst.data(), ddims, dlabels, T{3}, src.data(), sdims, slabels, true);
+  for(size_t a = 0; a < 8; a++) {
+    for(size_t b = 0; b < 16; b++) {
+      for(size_t c = 0; c < 10; c++) {
+        REQUIRE(dst[(c * 8 + a) * 16 + b] == T{3} * src[(a * 16 + b) * 10 + c]);
+      }
+    }
+  }
+}
+
+TEST_CASE("High-rank block permutations") {
+  using T = double;
+
+  // D(f,a,d,b,e,c) = 2 * S(a,b,c,d,e,f), then D += S again
+  const SizeVec     sdims{2, 3, 2, 3, 2, 4};
+  const IntLabelVec slabels{0, 1, 2, 3, 4, 5}, dlabels{5, 0, 3, 1, 4, 2};
+  SizeVec           ddims;
+  for(const auto l: dlabels) ddims.push_back(sdims[l]);
+
+  std::vector<T> src(288), dst(288);
+  std::iota(src.begin(), src.end(), T{1});
+  kernels::assign(dst.data(), ddims, dlabels, T{2}, src.data(), sdims, slabels, true);
+  kernels::assign(dst.data(), ddims, dlabels, T{1}, src.data(), sdims, slabels, false);
+
+  std::vector<size_t> sidx(6);
+  for(size_t e = 0; e < src.size(); e++) {
+    for(size_t d = 6, r = e; d-- > 0; r /= sdims[d].value()) sidx[d] = r % sdims[d].value();
+    size_t doff = 0;
+    for(size_t d = 0; d < 6; d++) doff = doff * ddims[d].value() + sidx[dlabels[d]];
+    REQUIRE(dst[doff] == T{3} * src[e]);
+  }
+}
+
+TEST_CASE("Block permutations with contiguous trailing dims") {
+  using T = double;
+
+  // D(b,a,c,d) = S(a,b,c,d) moves contiguous runs of c*d elements; D += 2 * S(b,a,c,d) is flat
+  const SizeVec     sdims{3, 2, 4, 5}, ddims{2, 3, 4, 5};
+  const IntLabelVec slabels{0, 1, 2, 3}, dlabels{1, 0, 2, 3};
+
+  std::vector<T> src(120), dst(120);
+  std::iota(src.begin(), src.end(), T{1});
+  kernels::assign(dst.data(), ddims, dlabels, T{1}, src.data(), sdims, slabels, true);
+  for(size_t a = 0; a < 3; a++) {
+    for(size_t b = 0; b < 2; b++) {
+      for(size_t r = 0; r < 20; r++) {
+        REQUIRE(dst[(b * 3 + a) * 20 + r] == src[(a * 2 + b) * 20 + r]);
+      }
+    }
+  }
+
+  std::vector<T> acc(dst);
+  kernels::assign(acc.data(), ddims, dlabels, T{2}, dst.data(), ddims, dlabels, false);
+  for(size_t i = 0; i < acc.size(); i++) REQUIRE(acc[i] == T{3} * dst[i]);
+}
+
+TEST_CASE("Ops with multithreaded block kernels") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  REQUIRE(ec->kernel_threads() >= 1);
+  ec->set_kernel_threads(2);
+
+  // single blocks large enough to be split across threads
+  TiledIndexSpace TIS{IndexSpace{range(0, 200)}, 200};
+  auto [i, j] = TIS.labels<2>("all");
+
+  Tensor<T> T1{TIS, TIS}, T2{TIS, TIS};
+  Scheduler{*ec}
+    .allocate(T1, T2)(T2() = 2)(T1() = 1)(T1(i, j) += 3.0 * T2(i, j))(T1(i, j) += T2(j, i))
+    .execute();
+  for(const IndexVector& blockid: T1.loop_nest()) {
+    std::vector<T> buf(T1.block_size(blockid));
+    T1.get(blockid, buf);
+    for(const auto v: buf) REQUIRE(v == 9.0);
+  }
+  Tensor<T>::deallocate(T1, T2);
+  delete ec;
+}
+
+TEST_CASE("Map and scan ops on local blocks") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  TiledIndexSpace TIS{IndexSpace{range(0, 20)}, 4};
+
+  Tensor<T> T1{TIS, TIS}, T2{TIS, TIS};
+  Scheduler{*ec}.allocate(T1, T2)(T1() = 1)(T2() = 3).execute();
+
+  // span functors work in place on the local buffer
+  auto set_twice = [](const Tensor<T>& t, const IndexVector& lhs_iv, span<T> lhs_buf,
+                      const IndexVector rhs_iv[], std::vector<T> rhs_buf[]) {
+    for(size_t i = 0; i < lhs_buf.size(); ++i) { lhs_buf[i] = 2 * rhs_buf[0][i]; }
+  };
+  auto update = [](const Tensor<T>& t, const IndexVector& lhs_iv, span<T> lhs_buf,
+                   const IndexVector rhs_iv[], std::vector<T> rhs_buf[]) {
+    for(size_t i = 0; i < lhs_buf.size(); ++i) { lhs_buf[i] += rhs_buf[0][i]; }
+  };
+  Scheduler{*ec}.gop(T1(), std::array<decltype(T2()), 1>{T2()}, set_twice).execute();
+  check_value(T1, (T) 6);
+  Scheduler{*ec}.gop(T1(), std::array<decltype(T2()), 1>{T2()}, update).execute();
+  check_value(T1, (T) 9);
+
+  T    lsum = 0, lcount = 0;
+  auto sum_block = [&](Tensor<T>& t, const IndexVector& iv, span<const T> buf) {
+    for(const auto v: buf) lsum += v;
+  };
+  auto count_block = [&](Tensor<T>& t, const IndexVector& iv, std::vector<T>& buf) {
+    lcount += buf.size();
+  };
+  Scheduler{*ec}.gop(T1(), sum_block).gop(T1(), count_block).execute();
+  REQUIRE(ec->pg().allreduce(&lsum, ReduceOp::sum) == 9.0 * 400);
+  REQUIRE(ec->pg().allreduce(&lcount, ReduceOp::sum) == 400);
+
+  Tensor<T>::deallocate(T1, T2);
+  delete ec;
+}
+
+TEST_CASE("Fused multi-term adds") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  TiledIndexSpace TIS{IndexSpace{range(0, 20)}, 6};
+  auto [i, j] = TIS.labels<2>("all");
+
+  Tensor<T> R{TIS, TIS}, X{TIS, TIS}, Y{TIS, TIS}, Z{TIS, TIS};
+  Scheduler{*ec}.allocate(R, X, Y, Z)(X() = 1)(Z() = 4).execute();
+  fill_by_index(Y, [](const auto& idx) { return T(idx[0] * 20 + idx[1]); });
+
+  REQUIRE((R(i, j) += 2.0 * X(i, j)).fuse(R(i, j) += Y(j, i)) != nullptr);
+  REQUIRE((R(i, j) = 2.0 * X(i, j)).fuse(R(i, j) += Y(j, i)) == nullptr);
+  REQUIRE((R(i, j) += 2.0 * X(i, j)).fuse(X(i, j) += Y(j, i)) == nullptr);
+
+  // R(i,j) = 2 + Y(j,i) - 2
+  Scheduler{*ec}(R(i, j) = 2.0 * X(i, j))(R(i, j) += Y(j, i))(R(i, j) += -0.5 * Z(i, j)).execute();
+  check_by_index(R, [](const auto& idx) { return T(idx[1] * 20 + idx[0]); });
+
+  // all terms with the layout of the LHS stream through the local buffers
+  Scheduler{*ec}(R() = X())(R() += 2.0 * Z())(R() += -3 * X()).execute();
+  check_value(R, (T) 6);
+
+  Tensor<T>::deallocate(R, X, Y, Z);
+  delete ec;
+}
+
+TEST_CASE("Permuted adds between tensors with the same distribution") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  TiledIndexSpace TIS{IndexSpace{range(0, 12)}, 4};
+  auto [i, j, k] = TIS.labels<3>("all");
+
+  Tensor<T> A{TIS, TIS, TIS}, B{TIS, TIS, TIS};
+  Scheduler{*ec}.allocate(A, B).execute();
+  fill_by_index(B, [](const auto& idx) { return T(idx[0] * 144 + idx[1] * 12 + idx[2]); });
+
+  Scheduler{*ec}(A(i, j, k) = 2.0 * B(k, i, j)).execute();
+  check_by_index(A, [](const auto& idx) { return 2.0 * (idx[2] * 144 + idx[0] * 12 + idx[1]); });
+
+  Tensor<T>::deallocate(A, B);
+  delete ec;
+}
+
+TEST_CASE("Exact copy between tensors with the same distribution") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  TiledIndexSpace TIS{IndexSpace{range(0, 18)}, 4};
+  auto [i, j] = TIS.labels<2>("all");
+
+  Tensor<T> A{TIS, TIS}, B{TIS, TIS};
+  Scheduler{*ec}.allocate(A, B)(A() = 5).execute();
+  fill_by_index(B, [](const auto& idx) { return T(idx[0] * 18 + idx[1]); });
+
+  Scheduler{*ec}.exact_copy(A(i, j), B(i, j)).execute();
+  check_by_index(A, [](const auto& idx) { return T(idx[0] * 18 + idx[1]); });
+
+  Tensor<T>::deallocate(A, B);
+  delete ec;
+}
+
+#if !defined(USE_UPCXX)
+TEST_CASE("Flat adds executed from a sub-group") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  TiledIndexSpace TIS{IndexSpace{range(0, 20)}, 6};
+  auto [i, j] = TIS.labels<2>("all");
+
+  Tensor<T> A{TIS, TIS}, B{TIS, TIS}, C{TIS, TIS};
+  Scheduler{*ec}.allocate(A, B, C)(C() = 7).execute();
+  fill_by_index(A, [](const auto& idx) { return T(idx[0] * 20 + idx[1]); });
+  fill_by_index(B, [](const auto& idx) { return T(1.0 + idx[0] - 0.5 * idx[1]); });
+
+  // rank 0 alone updates the buffers of every rank, streaming the remote ones in chunks that
+  // are smaller than a tile
+  MPI_Comm sub_comm;
+  MPI_Comm_split(pg.comm(), pg.rank() == 0 ? 0 : MPI_UNDEFINED, 0, &sub_comm);
+  if(sub_comm != MPI_COMM_NULL) {
+    ProcGroup sub_pg = ProcGroup::create_coll(sub_comm);
+    {
+      ExecutionContext sub_ec{sub_pg, DistributionKind::nw, MemoryManagerKind::ga};
+      AddOpOptions     opts;
+      opts.flat_chunk_size = 5;
+      (B(i, j) += 2.0 * A(i, j)).set_options(opts).execute(sub_ec);
+      (C(i, j) = A(i, j)).set_options(opts).execute(sub_ec);
+    }
+    sub_pg.destroy_coll();
+    MPI_Comm_free(&sub_comm);
+  }
+  pg.barrier();
+
+  check_by_index(B, [](const auto& idx) {
+    return 1.0 + idx[0] - 0.5 * idx[1] + 2.0 * (idx[0] * 20 + idx[1]);
+  });
+  check_by_index(C, [](const auto& idx) { return T(idx[0] * 20 + idx[1]); });
+
+  Tensor<T>::deallocate(A, B, C);
+  delete ec;
+}
+#endif
+
+TEST_CASE("Deferred zero fills") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  TiledIndexSpace TIS{IndexSpace{range(0, 14)}, 4};
+  auto [i, j, k] = TIS.labels<3>("all");
+
+  Tensor<T> A{TIS, TIS}, B{TIS, TIS}, C{TIS, TIS}, D{TIS, TIS};
+  // stale values the deferred zeros must hide
+  Scheduler{*ec}.allocate(A, B, C, D)(A() = 7)(B() = 7)(C() = 7)(D() = 2).execute();
+
+  // the first accumulate into a zeroed tensor assigns it
+  Scheduler{*ec}(A() = 0)(A() += 3.0 * D())(A() += D())(B() = 0)(B(i, j) += D(j, i)).execute();
+  check_value(A, (T) 8);
+  check_value(B, (T) 2);
+
+  Scheduler{*ec}(A() = 0)(A() += 5).execute();
+  check_value(A, (T) 5);
+
+  // zeros nothing overwrote are written before execute() returns
+  Scheduler{*ec}(C() = 0).execute();
+  check_value(C, (T) 0);
+
+  // contractions and reads see the zeros
+  Scheduler{*ec}(A() = 7)(B() = 7).execute();
+  Scheduler{*ec}(A() = 0)(A(i, j) += D(i, k) * D(k, j))(B() = 0)(C() = B()).execute();
+  check_value(A, (T) 56);
+  check_value(B, (T) 0);
+  check_value(C, (T) 0);
+
+  // a view shares the memory of its reference tensor, so reading it sees the zeros
+  Tensor<T> V{A, TiledIndexSpaceVec{TIS, TIS}, [](const IndexVector& blockid) { return blockid; }};
+  Scheduler{*ec}(A() = 7)(C() = 1).execute();
+  Scheduler{*ec}(A() = 0)(C(i, j) += V(i, k) * D(k, j)).execute();
+  check_value(C, (T) 1);
+  check_value(A, (T) 0);
+
+  // contractions into a zeroed tensor assign it, also on the general (scalar) path
+  Tensor<T> S{};
+  Scheduler{*ec}.allocate(S)(S() = 7)(A() = 7).execute();
+  Scheduler{*ec}(A() = 0)(A(i, j) += 0.5 * D(i, k) * D(k, j))(S() = 0)(S() += D(i, j) * D(i, j))
+    .execute();
+  check_value(A, (T) 28);
+  REQUIRE(get_scalar(S) == (T) 784);
+
+  Tensor<T>::deallocate(A, B, C, D, S);
+  delete ec;
+}
+
+TEST_CASE("Fused element-wise expressions") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+  using ewise::expr;
+
+  TiledIndexSpace TIS{IndexSpace{range(0, 14)}, 4};
+  auto [i, j] = TIS.labels<2>("all");
+
+  Tensor<T> A{TIS, TIS}, B{TIS, TIS}, C{TIS, TIS}, D{TIS, TIS}, Z{TIS, TIS};
+  Scheduler{*ec}.allocate(A, B, C, D, Z)(A() = 2)(B() = 3)(C() = 8)(D() = 4)(Z() = 7).execute();
+
+  Scheduler{*ec}(
+    ewise::assign(Z(i, j), expr(A(i, j)) * expr(B(i, j)) + expr(C(i, j)) / expr(D(i, j))))
+    .execute();
+  check_value(Z, (T) 8);
+
+  auto square = [](T x) { return x * x; };
+  Scheduler{*ec}(ewise::update(Z(), -expr(A()) * 0.5 + ewise::map(expr(B()), square))).execute();
+  check_value(Z, (T) 16);
+
+  // an update of a zeroed tensor, and an expression reading its own output
+  Scheduler{*ec}(Z() = 0)(ewise::update(Z(), 1.0 - expr(D())))(
+    ewise::assign(Z(), 2.0 * expr(Z()) + expr(A())))
+    .execute();
+  check_value(Z, (T) -4);
+
+  Tensor<T>::deallocate(A, B, C, D, Z);
+  delete ec;
+}
+
+TEST_CASE("K-panel aggregated contractions") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  // uneven last tile, so the panels mix reduction tiles of different widths
+  TiledIndexSpace TIS{IndexSpace{range(0, 30)}, 4};
+  auto [i, j, k] = TIS.labels<3>("all");
+
+  Tensor<T> A{TIS, TIS}, B{TIS, TIS}, C{TIS, TIS}, Cref{TIS, TIS};
+  Scheduler{*ec}.allocate(A, B, C, Cref).execute();
+  fill_by_index(A, [](const std::vector<size_t>& idx) { return 0.1 * idx[0] - 0.02 * idx[1]; });
+  fill_by_index(B,
+                [](const std::vector<size_t>& idx) { return 1.0 / (1.0 + idx[0] + 2 * idx[1]); });
+
+  MultOpOptions plain, kagg;
+  plain.kagg_mb = 0;
+  kagg.kagg_mb  = 1;
+
+  Scheduler{*ec}(Cref() = 0)(C() = 0)((Cref(i, j) += A(i, k) * B(k, j)).set_options(plain))(
+    (C(i, j) += A(i, k) * B(k, j)).set_options(kagg))
+    .execute();
+  check_equal(C, Cref);
+
+  // transposed A tiles are permuted while packing
+  Scheduler{*ec}((Cref(i, j) += 2.0 * A(k, i) * B(k, j)).set_options(plain))(
+    (C(i, j) += 2.0 * A(k, i) * B(k, j)).set_options(kagg))
+    .execute();
+  check_equal(C, Cref);
+
+  Tensor<T>::deallocate(A, B, C, Cref);
+  delete ec;
+}
+
+TEST_CASE("SUMMA contractions") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::dense, MemoryManagerKind::ga};
+  using T              = double;
+
+  TiledIndexSpace TIS{IndexSpace{range(0, 26)}, 5};
+  auto [i, j, k] = TIS.labels<3>("all");
+
+  Tensor<T> A{TIS, TIS}, B{TIS, TIS}, C{TIS, TIS}, Cref{TIS, TIS};
+  Scheduler{*ec}.allocate(A, B, C, Cref).execute();
+  fill_by_index(A, [](const std::vector<size_t>& idx) { return 0.3 * idx[0] - 0.1 * idx[1]; });
+  fill_by_index(B, [](const std::vector<size_t>& idx) { return 0.5 + idx[0] % 3 - 0.2 * idx[1]; });
+
+  MultOpOptions plain, summa;
+  plain.summa = false;
+  summa.summa = true;
+  Scheduler{*ec}(Cref() = 0)((Cref(i, j) += 1.5 * A(i, k) * B(k, j)).set_options(plain))
+    .execute();
+
+  // one layer on the process grid of C, then the reduction split across layers
+  for(int repl: {1, 2}) {
+    summa.summa_repl = repl;
+    Scheduler{*ec}(C() = 0)((C(i, j) += 1.5 * A(i, k) * B(k, j)).set_options(summa)).execute();
+    check_equal(C, Cref);
+  }
+
+  // permuted operands are packed into the panels
+  Scheduler{*ec}(Cref() = 0)((Cref(i, j) += A(k, i) * B(j, k)).set_options(plain))(C() = 0)(
+    (C(i, j) += A(k, i) * B(j, k)).set_options(summa))
+    .execute();
+  check_equal(C, Cref);
+
+  Tensor<T>::deallocate(A, B, C, Cref);
+  delete ec;
+}
+
+TEST_CASE("Contractions with replicated operand blocks") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  TiledIndexSpace TIS{IndexSpace{range(0, 24)}, 4};
+  TiledIndexSpace SIS{IndexSpace{range(0, 6)}, 2};
+  auto [i, j] = TIS.labels<2>("all");
+  auto [k]    = SIS.labels<1>("all");
+
+  // the small operand A is read for every column block of C
+  Tensor<T> A{TIS, SIS}, B{SIS, TIS}, C{TIS, TIS}, Cref{TIS, TIS};
+  Scheduler{*ec}.allocate(A, B, C, Cref).execute();
+  fill_by_index(A, [](const std::vector<size_t>& idx) { return 1.0 + idx[0] - 0.5 * idx[1]; });
+  fill_by_index(B, [](const std::vector<size_t>& idx) { return 0.25 * idx[0] + 0.1 * idx[1]; });
+
+  MultOpOptions plain, repl;
+  plain.replicate_mb = 0;
+  repl.replicate_mb  = 1;
+  Scheduler{*ec}(Cref() = 0)(C() = 0)((Cref(i, j) += A(i, k) * B(k, j)).set_options(plain))(
+    (C(i, j) += A(i, k) * B(k, j)).set_options(repl))
+    .execute();
+  check_equal(C, Cref);
+
+  // both operands replicated, B read transposed
+  Scheduler{*ec}((Cref(i, j) += 3.0 * A(i, k) * A(j, k)).set_options(plain))(
+    (C(i, j) += 3.0 * A(i, k) * A(j, k)).set_options(repl))
+    .execute();
+  check_equal(C, Cref);
+
+  Tensor<T>::deallocate(A, B, C, Cref);
+  delete ec;
+}
+
+TEST_CASE("Contractions with norm-based screening") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  TiledIndexSpace TIS{IndexSpace{range(0, 20)}, 4};
+  auto [i, j, k] = TIS.labels<3>("all");
+
+  // the first two row tiles of A are negligible, so their products with B fall below the
+  // threshold and are skipped
+  Tensor<T> A{TIS, TIS}, B{TIS, TIS}, C{TIS, TIS}, Cref{TIS, TIS};
+  Scheduler{*ec}.allocate(A, B, C, Cref).execute();
+  fill_by_index(A, [](const std::vector<size_t>& idx) {
+    return (idx[0] < 8 ? 1.0e-14 : 1.0) * (1.0 + 0.1 * idx[1]);
+  });
+  fill_by_index(B, [](const std::vector<size_t>& idx) { return 0.5 - 0.05 * (idx[0] + idx[1]); });
+
+  MultOpOptions plain, screen;
+  plain.screen_thresh  = 0.0;
+  screen.screen_thresh = 1.0e-8;
+
+  auto&        oprof           = OpProfiler::instance();
+  const double screened_before = oprof.multOpScreenedFlops;
+  Scheduler{*ec}(Cref() = 0)(C() = 0)((Cref(i, j) += A(i, k) * B(k, j)).set_options(plain))(
+    (C(i, j) += A(i, k) * B(k, j)).set_options(screen))
+    .execute();
+  check_equal(C, Cref, 1.0e-10);
+
+  double screened = oprof.multOpScreenedFlops - screened_before;
+  REQUIRE(ec->pg().allreduce(&screened, ReduceOp::sum) > 0.0);
+
+  Tensor<T>::deallocate(A, B, C, Cref);
+  delete ec;
+}
+
+TEST_CASE("Contractions with a split reduction") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  // a single C block with a long reduction, so ranks without a C block share its reduction
+  TiledIndexSpace OIS{IndexSpace{range(0, 6)}, 6};
+  TiledIndexSpace KIS{IndexSpace{range(0, 40)}, 3};
+  auto [i, j] = OIS.labels<2>("all");
+  auto [k]    = KIS.labels<1>("all");
+
+  Tensor<T> A{OIS, KIS}, B{KIS, OIS}, C{OIS, OIS}, Cref{OIS, OIS};
+  Scheduler{*ec}.allocate(A, B, C, Cref).execute();
+  fill_by_index(A, [](const std::vector<size_t>& idx) { return 0.2 * idx[0] + 0.01 * idx[1]; });
+  fill_by_index(B, [](const std::vector<size_t>& idx) { return 1.0 - 0.02 * idx[0] * idx[1]; });
+
+  MultOpOptions nosplit, split;
+  nosplit.split_min_tiles = 0;
+  split.split_min_tiles   = 1;
+  Scheduler{*ec}(Cref() = 0)(C() = 0)((Cref(i, j) += A(i, k) * B(k, j)).set_options(nosplit))(
+    (C(i, j) += A(i, k) * B(k, j)).set_options(split))
+    .execute();
+  check_equal(C, Cref);
+
+  Tensor<T>::deallocate(A, B, C, Cref);
+  delete ec;
+}
+
+TEST_CASE("Three-index contractions with bounded panels") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  // an A panel is 64 rows x 2200 reduction indices (1.1 MiB), split into chunks by a 1 MiB limit
+  TiledIndexSpace OIS{IndexSpace{range(0, 16)}, 8};
+  TiledIndexSpace QIS{IndexSpace{range(0, 2200)}, 200};
+  auto [a, b, i, j] = OIS.labels<4>("all");
+  auto [q]          = QIS.labels<1>("all");
+
+  Tensor<T> L{OIS, OIS, QIS}, X{OIS, OIS, OIS, OIS}, Xref{OIS, OIS, OIS, OIS};
+  Scheduler{*ec}.allocate(L, X, Xref).execute();
+  fill_by_index(L, [](const std::vector<size_t>& idx) {
+    return 1.0e-2 * (idx[0] + 2.0 * idx[1]) - 1.0e-4 * idx[2];
+  });
+
+  MultOpOptions plain, df;
+  plain.df_cache_mb = 0;
+  df.df_cache_mb    = 16;
+  Scheduler{*ec}(Xref() = 0)((Xref(a, b, i, j) += L(a, i, q) * L(b, j, q)).set_options(plain))
+    .execute();
+
+  for(size_t panel_mb: {0, 1}) {
+    df.df_panel_mb = panel_mb;
+    Scheduler{*ec}(X() = 0)((X(a, b, i, j) += L(a, i, q) * L(b, j, q)).set_options(df)).execute();
+    check_equal(X, Xref, 1.0e-8);
+  }
+
+  Tensor<T>::deallocate(L, X, Xref);
+  delete ec;
+}
+
+TEST_CASE("Contractions through the accumulation cache") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  // a scalar result goes through the general block loop, and every block pair contributes to
+  // the same output block
+  TiledIndexSpace TIS{IndexSpace{range(0, 18)}, 4};
+  auto [i, j] = TIS.labels<2>("all");
+
+  Tensor<T> A{TIS, TIS}, B{TIS, TIS}, s{}, sref{};
+  Scheduler{*ec}.allocate(A, B, s, sref).execute();
+  fill_by_index(A, [](const std::vector<size_t>& idx) { return 0.1 * idx[0] + 0.3 * idx[1]; });
+  fill_by_index(B, [](const std::vector<size_t>& idx) { return 1.0 - 0.05 * idx[0] * idx[1]; });
+
+  MultOpOptions nocache, cache;
+  nocache.acc_cache_mb = 0;
+  cache.acc_cache_mb   = 1;
+  Scheduler{*ec}(sref() = 0)(s() = 0)((sref() += A(i, j) * B(i, j)).set_options(nocache))(
+    (s() += A(i, j) * B(i, j)).set_options(cache))
+    .execute();
+  check_equal(s, sref);
+
+  // the reference value, transposed operand
+  double expected = 0.0;
+  for(size_t r = 0; r < 18; r++) {
+    for(size_t c = 0; c < 18; c++) expected += (0.1 * c + 0.3 * r) * (1.0 - 0.05 * r * c);
+  }
+  Scheduler{*ec}(s() = 0)((s() += A(j, i) * B(i, j)).set_options(cache)).execute();
+  check_by_index(s, [&](const std::vector<size_t>&) { return expected; }, 1.0e-8);
+
+  Tensor<T>::deallocate(A, B, s, sref);
+  delete ec;
+}
+
+TEST_CASE("Contractions executed without a scheduler") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  TiledIndexSpace TIS{IndexSpace{range(0, 18)}, 4};
+  auto [i, j, k] = TIS.labels<3>("all");
+
+  Tensor<T> A{TIS, TIS}, B{TIS, TIS}, C{TIS, TIS}, s{};
+  Scheduler{*ec}.allocate(A, B, C, s)(A() = 2)(B() = 3)(C() = 1)(s() = 1).execute();
+
+  // no atomic counter: the general block loop ends with a barrier, after which every update of
+  // the scalar must be visible to all ranks
+  auto sop = (s() += A(i, j) * B(i, j));
+  sop.execute(*ec);
+  REQUIRE(get_scalar(s) == (T) (1 + 6 * 18 * 18));
+
+  auto cop = (C(i, j) += A(i, k) * B(k, j));
+  cop.execute(*ec);
+  ec->pg().barrier();
+  check_value(C, (T) (1 + 6 * 18));
+
+  Tensor<T>::deallocate(A, B, C, s);
+  delete ec;
+}
+
+TEST_CASE("Batched accumulates across ranks") {
+  ProcGroup         pg = ProcGroup::create_world_coll();
+  ExecutionContext* ec = new ExecutionContext{pg, DistributionKind::nw, MemoryManagerKind::ga};
+  using T              = double;
+
+  // small blocks owned by all ranks are batched, 80 KB blocks bypass the batch
+  TiledIndexSpace SIS{IndexSpace{range(0, 30)}, 4};
+  TiledIndexSpace LIS{IndexSpace{range(0, 200)}, 100};
+
+  const double nranks = ec->pg().size().value();
+  const double weight = ec->pg().rank().value() + 1.0;
+  auto         value  = [](const std::vector<size_t>& idx) { return 1.0 + idx[0] - 0.5 * idx[1]; };
+
+  for(const auto& TIS: {SIS, LIS}) {
+    Tensor<T> R{TIS, TIS};
+    Scheduler{*ec}.allocate(R)(R() = 0).execute();
+
+    // every rank adds to every block twice, so ranges of a batch overlap
+    R.begin_acc_batch();
+    for(int rep = 0; rep < 2; rep++) {
+      for(const IndexVector& blockid: R.loop_nest()) {
+        std::vector<T> buf(R.block_size(blockid));
+        for_each_element(R, blockid, [&](size_t c, const std::vector<size_t>& idx) {
+          buf[c] = weight * value(idx);
+        });
+        R.add(blockid, buf);
+      }
+    }
+    R.end_acc_batch();
+    ec->pg().barrier();
+
+    // sum over ranks of 2 * (rank + 1)
+    check_by_index(R, [&](const std::vector<size_t>& idx) {
+      return nranks * (nranks + 1) * value(idx);
+    });
+    Tensor<T>::deallocate(R);
+  }
+  delete ec;
+}
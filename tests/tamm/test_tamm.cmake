@@ -2,6 +2,10 @@
 include(TargetMacros)
 add_cxx_unit_test(Test_IndexSpace)
 add_cxx_unit_test(Test_IndexLoopNest)
+add_cxx_unit_test(Test_Flat_Ops)
+# benchmark: built with the tests but not run by ctest
+add_cxx_unit_test(Bench_Flat_Ops)
+set_tests_properties(Bench_Flat_Ops PROPERTIES DISABLED TRUE)
 # add_mpi_unit_test(Test_Tensors 2 "")
 add_mpi_unit_test(Test_Ops 2 "")
 # add_mpi_unit_test(Test_OpsExpr 2 "")